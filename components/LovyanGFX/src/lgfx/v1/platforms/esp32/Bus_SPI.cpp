@@ -99,6 +99,13 @@ Contributors:
 
 #include <algorithm>
 
+// Optional tracing hooks, defined by the application to timestamp DMA transfers.
+// Completion is recorded when the CPU observes it (wait() / busy()), there is no interrupt.
+extern "C" void lgfx_trace_dma_begin(uint32_t length) __attribute__((weak));
+extern "C" void lgfx_trace_dma_end(void) __attribute__((weak));
+#define LGFX_TRACE_DMA_BEGIN(length) do { if (lgfx_trace_dma_begin) { lgfx_trace_dma_begin(length); } } while (0)
+#define LGFX_TRACE_DMA_END() do { if (lgfx_trace_dma_end) { lgfx_trace_dma_end(); } } while (0)
+
 namespace lgfx
 {
  inline namespace v1
@@ -271,11 +278,14 @@ namespace lgfx
   {
     auto spi_cmd_reg = _spi_cmd_reg;
     while (*spi_cmd_reg & SPI_USR);
+    LGFX_TRACE_DMA_END();
   }
 
   bool Bus_SPI::busy(void) const
   {
-    return (*_spi_cmd_reg & SPI_USR);
+    if (*_spi_cmd_reg & SPI_USR) { return true; }
+    LGFX_TRACE_DMA_END();
+    return false;
   }
 
   bool Bus_SPI::writeCommand(uint32_t data, uint_fast8_t bit_length)
@@ -576,6 +586,7 @@ namespace lgfx
         auto spi_dma_out_link_reg = _spi_dma_out_link_reg;
         auto cmd = _spi_cmd_reg;
         while (*cmd & SPI_USR) {}
+        LGFX_TRACE_DMA_END();
         *spi_dma_out_link_reg = 0;
         _setup_dma_desc_links(data, length);
 #if defined ( SOC_GDMA_SUPPORTED )
@@ -615,6 +626,7 @@ namespace lgfx
         if (_dma_ch) { spicommon_dmaworkaround_transfer_active(_dma_ch); }
  #endif
 #endif
+        LGFX_TRACE_DMA_BEGIN(length);
         exec_spi();
 
 #if defined ( SOC_GDMA_SUPPORTED )
@@ -753,6 +765,7 @@ label_start:
   {
     if (0 == _dma_queue_size) return;
 
+    uint32_t total_bytes = _dma_queue_bytes;
     int index = _dma_queue_size - 1;
     _dma_queue_size = 0;
     _dma_queue[index].eof = 1;
@@ -798,6 +811,7 @@ label_start:
     if (_dma_ch) { spicommon_dmaworkaround_transfer_active(_dma_ch); }
  #endif
 #endif
+    LGFX_TRACE_DMA_BEGIN(total_bytes);
     exec_spi();
 
 #if defined ( SOC_GDMA_SUPPORTED )
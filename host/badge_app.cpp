@@ -0,0 +1,33 @@
+#include "badge_app.h"
+
+#include <memory>
+
+#include "config.h"
+#include "user_info.h"
+#include "views/view_badge.h"
+#include "views/view_cat.h"
+#include "views/view_game.h"
+#include "views/view_plasma.h"
+#include "views/view_program.h"
+#include "views/view_qrcode.h"
+#include "views/view_settings.h"
+
+BadgeApp::BadgeApp(lgfx::IBus *bus) : display(lcd, state)
+{
+    Config::initNVS();
+    Config::loadFromNVS();
+    if (bus != nullptr)
+        lcd.attachBus(bus);
+    lcd.init();
+    display.init();
+
+    display.addView(std::make_unique<ViewBadge>(state, lcd));
+    display.addView(std::make_unique<ViewPlasma>(state, lcd));
+    display.addView(std::make_unique<ViewQRCode>());
+    display.addView(std::make_unique<ViewProgram>(state, lcd));
+    display.addView(std::make_unique<ViewGame>(state, lcd));
+    display.addView(std::make_unique<ViewCat>(state, lcd));
+    display.setSettingsView(std::make_unique<ViewSettings>(lcd, display));
+
+    user_info_generate_qrcode(user_info.accessBadgeToken.c_str());
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "display_manager.h"
+#include "lgfx_custom.h"
+#include "state.h"
+
+// Application du badge sur l'hôte : mêmes vues, dans le même ordre, que app_main (main/main.cpp),
+// sans les tâches d'affichage ni la console. Les frames sont produites par display.stepFrame().
+struct BadgeApp
+{
+    LGFX lcd;
+    AppState state;
+    DisplayManager display;
+
+    // bus : écran ILI9341 sur ce bus au lieu de l'écran en mémoire (LGFX::attachBus)
+    explicit BadgeApp(lgfx::IBus *bus = nullptr);
+};
@@ -0,0 +1,443 @@
+// Implémentation hôte du sous-ensemble ESP-IDF / FreeRTOS utilisé par main/ (voir include/)
+
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "driver/gpio.h"
+#include "driver/ledc.h"
+#include "esp_console.h"
+#include "esp_cpu.h"
+#include "esp_heap_caps.h"
+#include "esp_ipc.h"
+#include "esp_random.h"
+#include "esp_rom_sys.h"
+#include "esp_sleep.h"
+#include "esp_timer.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "host_clock.h"
+#include "nvs.h"
+#include "nvs_flash.h"
+
+// --- Horloge et aléa ---
+
+static int64_t s_clockOffsetUs = 0;
+static bool s_clockFrozen = false;
+static int64_t s_frozenUs = 0;
+static uint32_t s_randomState = 0x2545F491u;
+
+// Comme esp_timer_get_time() sur l'ESP32, l'horloge part de 0 au lancement
+static int64_t realTimeUs()
+{
+    using namespace std::chrono;
+    static const steady_clock::time_point s_start = steady_clock::now();
+    return duration_cast<microseconds>(steady_clock::now() - s_start).count();
+}
+
+int64_t esp_timer_get_time(void)
+{
+    if (s_clockFrozen)
+        return s_frozenUs;
+    return realTimeUs() + s_clockOffsetUs;
+}
+
+void host_clock_advance_to(int64_t us)
+{
+    int64_t now = esp_timer_get_time();
+    if (us <= now)
+        return;
+    if (s_clockFrozen)
+        s_frozenUs = us;
+    else
+        s_clockOffsetUs += us - now;
+}
+
+void host_clock_freeze(bool frozen)
+{
+    if (frozen == s_clockFrozen)
+        return;
+    if (frozen)
+        s_frozenUs = esp_timer_get_time();
+    else
+        s_clockOffsetUs = s_frozenUs - realTimeUs();
+    s_clockFrozen = frozen;
+}
+
+void host_random_seed(uint32_t seed)
+{
+    s_randomState = seed != 0 ? seed : 1;
+}
+
+// xorshift32 : même suite à chaque exécution pour une même graine
+uint32_t esp_random(void)
+{
+    uint32_t x = s_randomState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    s_randomState = x;
+    return x;
+}
+
+// --- CPU : un seul cœur, compteur de cycles à 1 GHz ---
+
+uint32_t esp_cpu_get_cycle_count(void)
+{
+    using namespace std::chrono;
+    return (uint32_t)duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+int esp_cpu_get_core_id(void)
+{
+    return 0;
+}
+
+uint32_t esp_rom_get_cpu_ticks_per_us(void)
+{
+    return 1000;
+}
+
+esp_err_t esp_ipc_call_blocking(uint32_t, esp_ipc_func_t func, void *arg)
+{
+    func(arg);
+    return ESP_OK;
+}
+
+const char *esp_err_to_name(esp_err_t code)
+{
+    return code == ESP_OK ? "ESP_OK" : "ESP_FAIL";
+}
+
+// --- Tas (non borné sur l'hôte : rien à mesurer) ---
+
+size_t heap_caps_get_free_size(uint32_t)
+{
+    return 0;
+}
+
+size_t heap_caps_get_largest_free_block(uint32_t)
+{
+    return 0;
+}
+
+// --- Timers (jamais déclenchés) ---
+
+struct esp_timer
+{
+    esp_timer_create_args_t args;
+};
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t *args, esp_timer_handle_t *out_handle)
+{
+    *out_handle = new esp_timer{*args};
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t, uint64_t)
+{
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t, uint64_t)
+{
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t)
+{
+    return ESP_OK;
+}
+
+// --- FreeRTOS : une seule tâche, pas de création de tâche ---
+
+BaseType_t xTaskCreate(TaskFunction_t, const char *, uint32_t, void *, UBaseType_t, TaskHandle_t *)
+{
+    return pdFAIL;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t, const char *, uint32_t, void *, UBaseType_t, TaskHandle_t *, BaseType_t)
+{
+    return pdFAIL;
+}
+
+void vTaskDelete(TaskHandle_t)
+{
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(ticks * portTICK_PERIOD_MS));
+}
+
+// Poignée unique de la tâche principale (non nulle, comme sur la cible)
+static int s_mainTask;
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+    return (TaskHandle_t)&s_mainTask;
+}
+
+char *pcTaskGetName(TaskHandle_t)
+{
+    static char s_name[] = "main";
+    return s_name;
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    return (TickType_t)(esp_timer_get_time() / 1000 / portTICK_PERIOD_MS);
+}
+
+BaseType_t xPortGetCoreID(void)
+{
+    return 0;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t, TickType_t)
+{
+    return 0;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t)
+{
+    return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t, BaseType_t *)
+{
+}
+
+// Files et sémaphores : création refusée, DisplayManager reste alors en mode une tâche
+QueueHandle_t xQueueCreate(UBaseType_t, UBaseType_t)
+{
+    return nullptr;
+}
+
+void vQueueDelete(QueueHandle_t)
+{
+}
+
+BaseType_t xQueueSend(QueueHandle_t, const void *, TickType_t)
+{
+    return pdFAIL;
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t, const void *, BaseType_t *)
+{
+    return pdFAIL;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t, void *, TickType_t)
+{
+    return pdFAIL;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+    return nullptr;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+    return nullptr;
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t)
+{
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t, TickType_t)
+{
+    return pdPASS;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t)
+{
+    return pdPASS;
+}
+
+// --- GPIO, LEDC et veille ---
+
+esp_err_t gpio_config(const gpio_config_t *)
+{
+    return ESP_OK;
+}
+
+// Entrées au repos : bouton BOOT relâché (pull-up), T_IRQ inactif
+int gpio_get_level(gpio_num_t)
+{
+    return 1;
+}
+
+esp_err_t gpio_install_isr_service(int)
+{
+    return ESP_OK;
+}
+
+esp_err_t gpio_isr_handler_add(gpio_num_t, gpio_isr_t, void *)
+{
+    return ESP_OK;
+}
+
+esp_err_t gpio_set_intr_type(gpio_num_t, gpio_int_type_t)
+{
+    return ESP_OK;
+}
+
+esp_err_t gpio_intr_enable(gpio_num_t)
+{
+    return ESP_OK;
+}
+
+esp_err_t gpio_intr_disable(gpio_num_t)
+{
+    return ESP_OK;
+}
+
+esp_err_t gpio_wakeup_enable(gpio_num_t, gpio_int_type_t)
+{
+    return ESP_OK;
+}
+
+esp_err_t gpio_wakeup_disable(gpio_num_t)
+{
+    return ESP_OK;
+}
+
+esp_err_t ledc_timer_config(const ledc_timer_config_t *)
+{
+    return ESP_OK;
+}
+
+esp_err_t ledc_channel_config(const ledc_channel_config_t *)
+{
+    return ESP_OK;
+}
+
+esp_err_t ledc_stop(ledc_mode_t, ledc_channel_t, uint32_t)
+{
+    return ESP_OK;
+}
+
+esp_err_t esp_sleep_pd_config(esp_sleep_pd_domain_t, esp_sleep_pd_option_t)
+{
+    return ESP_OK;
+}
+
+esp_err_t esp_sleep_enable_gpio_wakeup(void)
+{
+    return ESP_OK;
+}
+
+esp_err_t esp_sleep_enable_timer_wakeup(uint64_t)
+{
+    return ESP_OK;
+}
+
+esp_err_t esp_light_sleep_start(void)
+{
+    return ESP_OK;
+}
+
+// --- NVS en mémoire ---
+
+static std::map<std::string, std::vector<uint8_t>> s_nvs;
+
+static esp_err_t nvsSet(const char *key, const void *value, size_t length)
+{
+    const uint8_t *bytes = static_cast<const uint8_t *>(value);
+    s_nvs[key].assign(bytes, bytes + length);
+    return ESP_OK;
+}
+
+static esp_err_t nvsGet(const char *key, void *out, size_t length)
+{
+    auto it = s_nvs.find(key);
+    if (it == s_nvs.end() || it->second.size() != length)
+        return ESP_ERR_NVS_NOT_FOUND;
+    memcpy(out, it->second.data(), length);
+    return ESP_OK;
+}
+
+esp_err_t nvs_flash_init(void)
+{
+    return ESP_OK;
+}
+
+esp_err_t nvs_flash_erase(void)
+{
+    s_nvs.clear();
+    return ESP_OK;
+}
+
+esp_err_t nvs_open(const char *, nvs_open_mode_t, nvs_handle_t *out_handle)
+{
+    *out_handle = 1;
+    return ESP_OK;
+}
+
+esp_err_t nvs_set_u8(nvs_handle_t, const char *key, uint8_t value)
+{
+    return nvsSet(key, &value, sizeof(value));
+}
+
+esp_err_t nvs_get_u8(nvs_handle_t, const char *key, uint8_t *out_value)
+{
+    return nvsGet(key, out_value, sizeof(*out_value));
+}
+
+esp_err_t nvs_set_i32(nvs_handle_t, const char *key, int32_t value)
+{
+    return nvsSet(key, &value, sizeof(value));
+}
+
+esp_err_t nvs_get_i32(nvs_handle_t, const char *key, int32_t *out_value)
+{
+    return nvsGet(key, out_value, sizeof(*out_value));
+}
+
+esp_err_t nvs_set_blob(nvs_handle_t, const char *key, const void *value, size_t length)
+{
+    return nvsSet(key, value, length);
+}
+
+esp_err_t nvs_get_blob(nvs_handle_t, const char *key, void *out_value, size_t *length)
+{
+    return nvsGet(key, out_value, *length);
+}
+
+esp_err_t nvs_commit(nvs_handle_t)
+{
+    return ESP_OK;
+}
+
+void nvs_close(nvs_handle_t)
+{
+}
+
+// --- Console (commandes ignorées) ---
+
+esp_err_t esp_console_cmd_register(const esp_console_cmd_t *)
+{
+    return ESP_OK;
+}
+
+esp_err_t esp_console_register_help_command(void)
+{
+    return ESP_OK;
+}
+
+esp_err_t esp_console_new_repl_uart(const esp_console_dev_uart_config_t *, const esp_console_repl_config_t *,
+                                    esp_console_repl_t **)
+{
+    return ESP_FAIL;
+}
+
+esp_err_t esp_console_start_repl(esp_console_repl_t *)
+{
+    return ESP_FAIL;
+}
@@ -0,0 +1,384 @@
+// Tests de non-régression du rendu : chaque vue est rendue aux mêmes instants (horloge figée,
+// aléa initialisé) puis l'écran, copié dans un LGFX_Sprite, est comparé pixel à pixel à une
+// image de référence PNG (createPng / drawPng de LovyanGFX). Le test échoue aussi si le temps
+// médian d'une frame dépasse le budget enregistré pour la vue.
+//
+//   badge_golden --golden-dir DIR [--view NOM] [--check pixels|budget] [--tolerance N]
+//                [--out-dir DIR] [--update]
+//
+// --check limite le test aux pixels ou au budget de temps (les deux par défaut) : ctest les
+// lance séparément (labels golden et timing), le temps dépendant de la machine.
+// --update réécrit les références et/ou les budgets (médiane mesurée × BUDGET_MARGIN) des vues
+// testées. En cas d'échec, l'image obtenue et la carte des différences sont écrites dans
+// --out-dir (<vue>_<ms>.actual.png, <vue>_<ms>.diff.png).
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "badge_app.h"
+#include "host_clock.h"
+
+// Instants de capture après l'affichage de la vue : fin de transition et animation avancée
+static const int CAPTURE_TIMES_MS[] = {500, 2000};
+// Écart toléré par canal (0-255) : arrondis flottants d'un compilateur à l'autre
+#define DEFAULT_TOLERANCE 8
+#define RANDOM_SEED 1
+#define CLOCK_ORIGIN_US 1000000LL
+// Chaque vue est testée dans une application neuve démarrant à un instant fixe : le résultat
+// ne dépend pas des vues testées avant elle (premier dt, caches, sprites)
+#define VIEW_SLOT_US 60000000LL
+#define STATIC_VIEW_FPS 30
+#define BUDGET_MARGIN 4
+// Plancher des budgets : protège seulement les vues très rapides du bruit de l'ordonnanceur
+#define BUDGET_MIN_US 100
+#define BUDGETS_FILE "budgets.txt"
+
+struct Options
+{
+    std::string goldenDir;
+    std::string outDir = ".";
+    std::string view;
+    int tolerance = DEFAULT_TOLERANCE;
+    bool update = false;
+    bool checkPixels = true;
+    bool checkBudget = true;
+};
+
+struct CompareResult
+{
+    bool sizeMatches = false;
+    uint32_t mismatches = 0;
+    int maxDiff = 0;
+    int firstX = -1;
+    int firstY = -1;
+};
+
+static void usage(const char *program)
+{
+    fprintf(stderr,
+            "Usage: %s --golden-dir DIR [--view NAME] [--check pixels|budget] [--tolerance N] [--out-dir DIR] "
+            "[--update]\n",
+            program);
+}
+
+static bool parseOptions(int argc, char **argv, Options &options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        if (strcmp(arg, "--update") == 0)
+        {
+            options.update = true;
+            continue;
+        }
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (value == nullptr)
+            return false;
+        if (strcmp(arg, "--golden-dir") == 0)
+            options.goldenDir = value;
+        else if (strcmp(arg, "--out-dir") == 0)
+            options.outDir = value;
+        else if (strcmp(arg, "--view") == 0)
+            options.view = value;
+        else if (strcmp(arg, "--tolerance") == 0)
+            options.tolerance = std::max(0, atoi(value));
+        else if (strcmp(arg, "--check") == 0)
+        {
+            options.checkPixels = strcmp(value, "pixels") == 0;
+            options.checkBudget = strcmp(value, "budget") == 0;
+            if (!options.checkPixels && !options.checkBudget)
+                return false;
+        }
+        else
+            return false;
+        i++;
+    }
+    return !options.goldenDir.empty();
+}
+
+static bool readFile(const std::string &path, std::vector<uint8_t> &data)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        return false;
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+static bool writeFile(const std::string &path, const void *data, size_t length)
+{
+    std::ofstream file(path, std::ios::binary);
+    file.write(static_cast<const char *>(data), length);
+    return file.good();
+}
+
+static bool writePng(LGFX_Sprite &sprite, const std::string &path)
+{
+    size_t length = 0;
+    // Taille explicite : createPng() refuse la largeur 0 par défaut
+    void *png = sprite.createPng(&length, 0, 0, sprite.width(), sprite.height());
+    if (png == nullptr)
+        return false;
+    bool ok = writeFile(path, png, length);
+    free(png);
+    return ok;
+}
+
+// Budgets par vue : une ligne "<vue> <budget us>", lignes # ignorées
+static std::map<std::string, int64_t> readBudgets(const std::string &path)
+{
+    std::map<std::string, int64_t> budgets;
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.empty() || line[0] == '#')
+            continue;
+        std::istringstream fields(line);
+        std::string name;
+        int64_t budgetUs = 0;
+        if (fields >> name >> budgetUs)
+            budgets[name] = budgetUs;
+    }
+    return budgets;
+}
+
+static bool writeBudgets(const std::string &path, const std::map<std::string, int64_t> &budgets)
+{
+    std::ofstream file(path);
+    file << "# Temps médian maximal d'une frame (us) par vue, build Release. Écrit par badge_golden --update\n";
+    for (const auto &entry : budgets)
+        file << entry.first << " " << entry.second << "\n";
+    return file.good();
+}
+
+static void channels(uint16_t rgb565, int &r, int &g, int &b)
+{
+    r = (rgb565 >> 11) << 3;
+    g = ((rgb565 >> 5) & 0x3F) << 2;
+    b = (rgb565 & 0x1F) << 3;
+}
+
+// Compare actual à expected ; les pixels hors tolérance sont marqués dans diff
+static CompareResult compare(LGFX_Sprite &actual, LGFX_Sprite &expected, LGFX_Sprite &diff, int tolerance)
+{
+    CompareResult result;
+    result.sizeMatches = actual.width() == expected.width() && actual.height() == expected.height();
+    if (!result.sizeMatches)
+        return result;
+
+    for (int y = 0; y < actual.height(); y++)
+    {
+        for (int x = 0; x < actual.width(); x++)
+        {
+            int r1, g1, b1, r2, g2, b2;
+            channels(actual.readPixel(x, y), r1, g1, b1);
+            channels(expected.readPixel(x, y), r2, g2, b2);
+            int d = std::max({abs(r1 - r2), abs(g1 - g2), abs(b1 - b2)});
+            result.maxDiff = std::max(result.maxDiff, d);
+            if (d <= tolerance)
+                continue;
+            if (result.mismatches == 0)
+            {
+                result.firstX = x;
+                result.firstY = y;
+            }
+            result.mismatches++;
+            diff.drawPixel(x, y, TFT_RED);
+        }
+    }
+    return result;
+}
+
+// PNG de référence : largeur et hauteur lues dans l'en-tête IHDR
+static bool loadPng(const std::vector<uint8_t> &png, LGFX_Sprite &sprite)
+{
+    if (png.size() < 24)
+        return false;
+    auto be32 = [&](size_t offset)
+    { return (int32_t)(png[offset] << 24 | png[offset + 1] << 16 | png[offset + 2] << 8 | png[offset + 3]); };
+    if (sprite.createSprite(be32(16), be32(20)) == nullptr)
+        return false;
+    sprite.fillScreen(TFT_BLACK);
+    return sprite.drawPng(png.data(), png.size());
+}
+
+static int64_t median(std::vector<int64_t> values)
+{
+    if (values.empty())
+        return 0;
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+// Rend la vue index jusqu'à chaque instant de capture. Retourne le nombre d'échecs.
+static int runView(size_t index, const Options &options, std::map<std::string, int64_t> &budgets)
+{
+    int64_t origin = CLOCK_ORIGIN_US + (int64_t)(index + 1) * VIEW_SLOT_US;
+    host_clock_advance_to(origin);
+    host_random_seed(RANDOM_SEED);
+    std::unique_ptr<BadgeApp> instance(new BadgeApp());
+    BadgeApp &app = *instance;
+
+    DisplayManager &display = app.display;
+    View *view = display.viewAt(index);
+    const char *name = view->getName();
+    int failures = 0;
+    display.showView(index);
+
+    int fps = view->targetFps();
+    int64_t dtUs = 1000000 / (fps > 0 ? fps : STATIC_VIEW_FPS);
+    int64_t now = origin;
+    std::vector<int64_t> frameUs;
+
+    for (int captureMs : CAPTURE_TIMES_MS)
+    {
+        int64_t captureUs = origin + (int64_t)captureMs * 1000;
+        while (now + dtUs <= captureUs)
+        {
+            now += dtUs;
+            host_clock_advance_to(now);
+            // Une vue statique n'est rendue que sur demande : redessinée à chaque pas, pour la mesure
+            if (fps <= 0)
+                view->requestRedraw();
+            auto start = std::chrono::steady_clock::now();
+            bool produced = display.stepFrame(now);
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            if (produced)
+                frameUs.push_back(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+        }
+        if (!options.checkPixels)
+            continue;
+
+        LGFX_Sprite actual(&app.lcd);
+        actual.setColorDepth(16);
+        actual.createSprite(app.lcd.width(), app.lcd.height());
+        app.lcd.readRect(0, 0, app.lcd.width(), app.lcd.height(), (lgfx::swap565_t *)actual.getBuffer());
+
+        std::string stem = std::string(name) + "_" + std::to_string(captureMs);
+        std::string goldenPath = options.goldenDir + "/" + stem + ".png";
+        if (options.update)
+        {
+            if (!writePng(actual, goldenPath))
+            {
+                printf("FAIL %s: cannot write %s\n", stem.c_str(), goldenPath.c_str());
+                failures++;
+            }
+            else
+                printf("UPDATED %s\n", goldenPath.c_str());
+            continue;
+        }
+
+        std::vector<uint8_t> png;
+        LGFX_Sprite expected(&app.lcd);
+        expected.setColorDepth(16);
+        if (!readFile(goldenPath, png) || !loadPng(png, expected))
+        {
+            printf("FAIL %s: missing or unreadable reference %s (run with --update)\n", stem.c_str(),
+                   goldenPath.c_str());
+            failures++;
+            continue;
+        }
+
+        LGFX_Sprite diff(&app.lcd);
+        diff.setColorDepth(16);
+        diff.createSprite(actual.width(), actual.height());
+        diff.fillScreen(TFT_BLACK);
+        CompareResult result = compare(actual, expected, diff, options.tolerance);
+        if (result.sizeMatches && result.mismatches == 0)
+        {
+            printf("OK   %s (max diff %d)\n", stem.c_str(), result.maxDiff);
+            continue;
+        }
+
+        failures++;
+        if (!result.sizeMatches)
+            printf("FAIL %s: size %dx%d, reference %dx%d\n", stem.c_str(), actual.width(), actual.height(),
+                   expected.width(), expected.height());
+        else
+            printf("FAIL %s: %lu pixels beyond tolerance %d (max diff %d, first at %d,%d)\n", stem.c_str(),
+                   (unsigned long)result.mismatches, options.tolerance, result.maxDiff, result.firstX, result.firstY);
+        writePng(actual, options.outDir + "/" + stem + ".actual.png");
+        if (result.sizeMatches)
+            writePng(diff, options.outDir + "/" + stem + ".diff.png");
+    }
+
+    if (!options.checkBudget)
+        return failures;
+
+    int64_t medianUs = median(frameUs);
+    if (options.update)
+    {
+        budgets[name] = std::max<int64_t>(BUDGET_MIN_US, medianUs * BUDGET_MARGIN);
+        printf("BUDGET %s: %lld us (median %lld us)\n", name, (long long)budgets[name], (long long)medianUs);
+    }
+    else if (budgets.count(name) == 0)
+    {
+        printf("FAIL %s: no time budget in %s (run with --update)\n", name, BUDGETS_FILE);
+        failures++;
+    }
+    else if (medianUs > budgets[name])
+    {
+        printf("FAIL %s: median frame %lld us over budget %lld us\n", name, (long long)medianUs,
+               (long long)budgets[name]);
+        failures++;
+    }
+    else
+        printf("OK   %s: median frame %lld us (budget %lld us)\n", name, (long long)medianUs,
+               (long long)budgets[name]);
+    return failures;
+}
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+    {
+        usage(argv[0]);
+        return 2;
+    }
+
+    // Horloge figée avant toute construction : les vues ne voient que les instants demandés
+    host_clock_freeze(true);
+    host_clock_advance_to(CLOCK_ORIGIN_US);
+    std::vector<std::string> names;
+    {
+        BadgeApp app;
+        for (size_t index = 0; index < app.display.viewCount(); index++)
+            names.push_back(app.display.viewAt(index)->getName());
+    }
+
+    std::string budgetsPath = options.goldenDir + "/" + BUDGETS_FILE;
+    std::map<std::string, int64_t> budgets = readBudgets(budgetsPath);
+
+    int failures = 0;
+    bool found = false;
+    for (size_t index = 0; index < names.size(); index++)
+    {
+        if (!options.view.empty() && options.view != names[index])
+            continue;
+        found = true;
+        failures += runView(index, options, budgets);
+    }
+
+    if (!found)
+    {
+        fprintf(stderr, "Unknown view: %s\n", options.view.c_str());
+        return 2;
+    }
+    if (options.update && options.checkBudget && !writeBudgets(budgetsPath, budgets))
+    {
+        fprintf(stderr, "Cannot write %s\n", budgetsPath.c_str());
+        return 1;
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,35 @@
+#include "host_lgfx.h"
+
+#include <cstdlib>
+#include <cstring>
+
+Panel_Headless::~Panel_Headless()
+{
+    free(_lines_buffer);
+    free(m_pixels);
+}
+
+bool Panel_Headless::init(bool use_reset)
+{
+    const int width = _cfg.panel_width;
+    const int height = _cfg.panel_height;
+    if (m_pixels == nullptr)
+    {
+        m_pixels = (uint16_t *)calloc((size_t)width * height, sizeof(uint16_t));
+        _lines_buffer = (uint8_t **)malloc(height * sizeof(uint8_t *));
+        if (m_pixels == nullptr || _lines_buffer == nullptr)
+            return false;
+        for (int y = 0; y < height; y++)
+            _lines_buffer[y] = (uint8_t *)(m_pixels + (size_t)y * width);
+    }
+    setColorDepth(lgfx::color_depth_t::rgb565_2Byte);
+    return Panel_FrameBufferBase::init(use_reset);
+}
+
+// Le framebuffer est toujours en RGB565, comme la GRAM de l'ILI9341 en mode 16 bits
+lgfx::color_depth_t Panel_Headless::setColorDepth(lgfx::color_depth_t)
+{
+    _write_depth = lgfx::color_depth_t::rgb565_2Byte;
+    _read_depth = lgfx::color_depth_t::rgb565_2Byte;
+    return _write_depth;
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+#include <stdint.h>
+
+// Compteur de cycles simulé : une "horloge CPU" d'1 GHz tirée du temps réel (pas de l'horloge
+// figée des tests), le cœur est toujours 0
+uint32_t esp_cpu_get_cycle_count(void);
+int esp_cpu_get_core_id(void);
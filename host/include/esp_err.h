@@ -0,0 +1,17 @@
+#pragma once
+
+// Build hôte : sous-ensemble de l'API ESP-IDF utilisé par main/ (implémentation dans esp_stubs.cpp)
+
+typedef int esp_err_t;
+
+#define ESP_OK 0
+#define ESP_FAIL -1
+#define ESP_ERR_NO_MEM 0x101
+#define ESP_ERR_NOT_FOUND 0x105
+#define ESP_ERR_NVS_NOT_FOUND 0x1102
+#define ESP_ERR_NVS_NO_FREE_PAGES 0x110d
+#define ESP_ERR_NVS_NEW_VERSION_FOUND 0x1110
+
+#define ESP_ERROR_CHECK(x) (void)(x)
+
+const char *esp_err_to_name(esp_err_t code);
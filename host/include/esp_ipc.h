@@ -0,0 +1,10 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "esp_err.h"
+
+// Un seul cœur : la fonction est appelée directement
+typedef void (*esp_ipc_func_t)(void *arg);
+
+esp_err_t esp_ipc_call_blocking(uint32_t cpu_id, esp_ipc_func_t func, void *arg);
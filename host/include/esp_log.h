@@ -0,0 +1,14 @@
+#pragma once
+
+#include <stdio.h>
+
+// Logs sur stderr : la sortie standard reste aux résultats du benchmark
+#define ESP_LOGE(tag, fmt, ...) fprintf(stderr, "E %s: " fmt "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...) fprintf(stderr, "W %s: " fmt "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGI(tag, fmt, ...) fprintf(stderr, "I %s: " fmt "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGD(tag, fmt, ...)                                     \
+    do                                                              \
+    {                                                               \
+        if (0)                                                      \
+            fprintf(stderr, "D %s: " fmt "\n", tag, ##__VA_ARGS__); \
+    } while (0)
@@ -0,0 +1,6 @@
+#pragma once
+
+#include <stdint.h>
+
+// Suite pseudo-aléatoire reproductible (voir host_clock.h : host_random_seed)
+uint32_t esp_random(void);
@@ -0,0 +1,6 @@
+#pragma once
+
+#include <stdint.h>
+
+// Fréquence du compteur de esp_cpu_get_cycle_count()
+uint32_t esp_rom_get_cpu_ticks_per_us(void);
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <stdint.h>
+
+// Pilotage du temps et de l'aléa du build hôte (benchmark et tests)
+
+// Avance esp_timer_get_time() jusqu'à us si elle est en retard ; le temps continue ensuite
+// de s'écouler au rythme réel, les durées mesurées restent donc réelles
+void host_clock_advance_to(int64_t us);
+
+// Horloge figée : esp_timer_get_time() ne change plus qu'avec host_clock_advance_to(), pour
+// que le contenu des frames ne dépende que des instants demandés (tests de rendu)
+void host_clock_freeze(bool frozen);
+
+// Réinitialise la suite d'esp_random() pour des rendus reproductibles
+void host_random_seed(uint32_t seed);
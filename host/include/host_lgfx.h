@@ -0,0 +1,72 @@
+#pragma once
+
+#include "LovyanGFX.hpp"
+#include <lgfx/v1/panel/Panel_FrameBufferBase.hpp>
+#include <lgfx/v1/panel/Panel_ILI9341.hpp>
+
+#include <cstdint>
+
+// Écran du badge pour le build hôte : framebuffer RGB565 en mémoire, relu par readRect()
+// ou pixels(), sans bus, rétroéclairage ni touch. Même géométrie que l'ILI9341 du CYD.
+class Panel_Headless : public lgfx::Panel_FrameBufferBase
+{
+public:
+    ~Panel_Headless();
+
+    bool init(bool use_reset) override;
+    lgfx::color_depth_t setColorDepth(lgfx::color_depth_t depth) override;
+
+    // Pixels RGB565 octets inversés (format des sprites), lignes de la mémoire de l'écran
+    const uint16_t *pixels() const { return m_pixels; }
+
+private:
+    uint16_t *m_pixels = nullptr;
+};
+
+class LGFX : public lgfx::LGFX_Device
+{
+    Panel_Headless _panel_instance;
+    lgfx::Panel_ILI9341 _bus_panel;
+
+public:
+    LGFX(void)
+    {
+        auto cfg = _panel_instance.config();
+        cfg.memory_width = 320;
+        cfg.memory_height = 240;
+        cfg.panel_width = 320;
+        cfg.panel_height = 240;
+        cfg.offset_x = 0;
+        cfg.offset_y = 0;
+        cfg.offset_rotation = 5; // Portrait, comme sur le badge
+        _panel_instance.config(cfg);
+        setPanel(&_panel_instance);
+    }
+
+    // Remplace l'écran en mémoire par l'ILI9341 de la carte, même configuration, sur bus
+    // (BusRecorder sans cible : profil du trafic SPI). Rien n'est plus affiché ni relu.
+    // À appeler avant init().
+    void attachBus(lgfx::IBus *bus)
+    {
+        auto cfg = _bus_panel.config();
+        cfg.pin_cs = -1;
+        cfg.pin_rst = -1;
+        cfg.pin_busy = -1;
+        cfg.memory_width = 320;
+        cfg.memory_height = 240;
+        cfg.panel_width = 320;
+        cfg.panel_height = 240;
+        cfg.offset_x = 0;
+        cfg.offset_y = 0;
+        cfg.offset_rotation = 5;
+        cfg.readable = false;
+        cfg.rgb_order = true;
+        cfg.dlen_16bit = false;
+        cfg.bus_shared = false;
+        _bus_panel.config(cfg);
+        _bus_panel.setBus(bus);
+        setPanel(&_bus_panel);
+    }
+
+    const Panel_Headless &headlessPanel() const { return _panel_instance; }
+};
@@ -0,0 +1,182 @@
+// Benchmark hôte du rendu des vues : chaque vue produit N frames à dt fixe par le pipeline
+// de DisplayManager (update, rendu, envoi vers l'écran en mémoire), puis le temps moyen et
+// maximal par frame et par étape est affiché.
+//
+//   badge_benchmark [--frames N] [--warmup N] [--dt-ms X] [--view NOM] [--bus]
+//
+// Par défaut dt est la période de la vue (targetFps(), 30 images/s pour une vue statique,
+// redessinée à chaque frame) ; avec --dt-ms plus court que cette période, des frames ne sont
+// pas dues et ne sont pas comptées.
+// --bus : les frames sont envoyées à un ILI9341 sur un BusRecorder (rien n'est transmis) et le
+// trafic SPI par frame de chaque vue est affiché ensuite : octets, transactions, setWindow.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "badge_app.h"
+#include "bus_recorder.h"
+#include "esp_timer.h"
+#include "host_clock.h"
+
+#define DEFAULT_FRAMES 300
+// Frames non mesurées au début de chaque vue : transition d'entrée, allocation des sprites
+#define DEFAULT_WARMUP 30
+#define STATIC_VIEW_FPS 30
+#define RANDOM_SEED 1
+// Fréquence d'écriture du bus de l'écran sur la carte (lgfx_custom.h)
+#define BUS_CLOCK_HZ 40000000
+
+struct Options
+{
+    int frames = DEFAULT_FRAMES;
+    int warmup = DEFAULT_WARMUP;
+    double dtMs = 0.0; // 0 : période de la vue
+    std::string view;
+    bool bus = false;
+};
+
+struct StageStats
+{
+    int64_t sumUs = 0;
+    int64_t maxUs = 0;
+
+    void add(int64_t us)
+    {
+        sumUs += us;
+        maxUs = std::max(maxUs, us);
+    }
+};
+
+static void usage(const char *program)
+{
+    fprintf(stderr, "Usage: %s [--frames N] [--warmup N] [--dt-ms X] [--view NAME] [--bus]\n", program);
+}
+
+static bool parseOptions(int argc, char **argv, Options &options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        if (strcmp(arg, "--bus") == 0)
+        {
+            options.bus = true;
+            continue;
+        }
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (value == nullptr)
+            return false;
+        if (strcmp(arg, "--frames") == 0)
+            options.frames = std::max(1, atoi(value));
+        else if (strcmp(arg, "--warmup") == 0)
+            options.warmup = std::max(0, atoi(value));
+        else if (strcmp(arg, "--dt-ms") == 0)
+            options.dtMs = atof(value);
+        else if (strcmp(arg, "--view") == 0)
+            options.view = value;
+        else
+            return false;
+        i++;
+    }
+    return true;
+}
+
+static void printRow(const char *name, int fps, int frames, const StageStats &frame, const StageStats &update,
+                     const StageStats &render, const StageStats &push)
+{
+    if (frames == 0)
+    {
+        printf("%-10s %4d %7d %s\n", name, fps, 0, "(no frame due)");
+        return;
+    }
+    printf("%-10s %4d %7d %9lld %9lld %9lld %9lld %9lld\n", name, fps, frames,
+           (long long)(frame.sumUs / frames), (long long)frame.maxUs, (long long)(update.sumUs / frames),
+           (long long)(render.sumUs / frames), (long long)(push.sumUs / frames));
+}
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+    {
+        usage(argv[0]);
+        return 2;
+    }
+
+    host_random_seed(RANDOM_SEED);
+    BusRecorder recorder;
+    recorder.setClock(BUS_CLOCK_HZ);
+    BadgeApp app(options.bus ? &recorder : nullptr);
+    DisplayManager &display = app.display;
+    if (options.bus)
+        display.setBusRecorder(&recorder);
+    std::vector<std::pair<const char *, BusRecorder::Counters>> busRows;
+
+    printf("%-10s %4s %7s %9s %9s %9s %9s %9s\n", "view", "fps", "frames", "frame us", "max us", "update", "render",
+           "push");
+
+    bool found = options.view.empty();
+    for (size_t index = 0; index < display.viewCount(); index++)
+    {
+        View *view = display.viewAt(index);
+        if (!options.view.empty() && options.view != view->getName())
+            continue;
+        found = true;
+
+        host_random_seed(RANDOM_SEED);
+        display.showView(index);
+
+        int fps = view->targetFps();
+        int64_t dtUs = options.dtMs > 0.0 ? (int64_t)(options.dtMs * 1000.0)
+                                           : 1000000 / (fps > 0 ? fps : STATIC_VIEW_FPS);
+        int64_t now = esp_timer_get_time();
+
+        StageStats frame, update, render, push;
+        int measured = 0;
+        for (int i = 0; i < options.warmup + options.frames; i++)
+        {
+            now += dtUs;
+            host_clock_advance_to(now);
+            // Trafic du bus compté sur les seules frames mesurées
+            if (i == options.warmup)
+                recorder.clear();
+            // Une vue statique n'est rendue que sur demande
+            if (fps <= 0)
+                view->requestRedraw();
+
+            int64_t start = esp_timer_get_time();
+            if (!display.stepFrame(now))
+                continue;
+            int64_t elapsed = esp_timer_get_time() - start;
+            if (i < options.warmup)
+                continue;
+
+            DisplayManager::FrameTiming timing = display.lastFrameTiming();
+            frame.add(elapsed);
+            update.add(timing.updateUs);
+            render.add(timing.renderUs);
+            push.add(timing.pushUs);
+            measured++;
+        }
+        printRow(view->getName(), fps, measured, frame, update, render, push);
+        busRows.push_back({view->getName(), recorder.viewCounters(view->getName())});
+    }
+
+    if (!found)
+    {
+        fprintf(stderr, "Unknown view: %s\n", options.view.c_str());
+        return 1;
+    }
+
+    if (options.bus)
+    {
+        printf("\nLCD bus traffic per frame (%d MHz)\n", BUS_CLOCK_HZ / 1000000);
+        BusRecorder::printHeader();
+        for (const auto &row : busRows)
+            BusRecorder::printRow(row.first, row.second, BUS_CLOCK_HZ);
+    }
+    return 0;
+}
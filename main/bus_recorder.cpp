@@ -0,0 +1,421 @@
+#include "bus_recorder.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "esp_console.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+// Commandes de fenêtre de l'ILI9341 (Panel_LCD::setWindow)
+#define CMD_CASET 0x2A
+#define CMD_RASET 0x2B
+#define CMD_RAMWR 0x2C
+// Derniers événements affichés par "bus log" (au plus RING_SIZE)
+#define DUMP_EVENT_COUNT 64
+
+BusRecorder *BusRecorder::s_instance = nullptr;
+
+static const char *eventName(uint8_t kind)
+{
+    switch (kind)
+    {
+    case BusRecorder::Transaction:
+        return "begin";
+    case BusRecorder::Command:
+        return "cmd";
+    case BusRecorder::Window:
+        return "window";
+    case BusRecorder::Pixels:
+        return "pixels";
+    case BusRecorder::Data:
+        return "data";
+    case BusRecorder::Dma:
+        return "dma";
+    default:
+        return "?";
+    }
+}
+
+BusRecorder::~BusRecorder()
+{
+    free(m_dmaBuffers[0]);
+    free(m_dmaBuffers[1]);
+}
+
+void BusRecorder::setClock(uint32_t freq)
+{
+    m_clock = freq;
+    if (m_target)
+        m_target->setClock(freq);
+}
+
+void BusRecorder::record(EventKind kind, uint8_t value, uint32_t bytes)
+{
+    uint32_t now = (uint32_t)esp_timer_get_time();
+    portENTER_CRITICAL(&m_lock);
+    m_ring[m_eventCount % RING_SIZE] = {now, bytes, kind, value};
+    m_eventCount++;
+    portEXIT_CRITICAL(&m_lock);
+}
+
+// Données (D/C haut) : adresses de fenêtre, pixels ou paramètres selon la dernière commande
+void BusRecorder::countData(uint32_t bytes, bool dma)
+{
+    m_frame.bytes += bytes;
+    if (dma)
+        m_frame.dmaTransfers++;
+    switch (m_dataTarget)
+    {
+    case Address:
+        m_windowBytes += bytes;
+        break;
+    case Memory:
+        m_frame.pixelBytes += bytes;
+        record(dma ? Dma : Pixels, CMD_RAMWR, bytes);
+        break;
+    default:
+        record(dma ? Dma : Data, 0, bytes);
+        break;
+    }
+}
+
+void BusRecorder::countCommand(uint8_t cmd, uint32_t bytes)
+{
+    m_frame.commands++;
+    m_frame.bytes += bytes;
+    if (cmd == CMD_CASET || cmd == CMD_RASET)
+    {
+        m_windowBytes += bytes;
+        m_dataTarget = Address;
+        return;
+    }
+    if (cmd == CMD_RAMWR)
+    {
+        m_windowBytes += bytes;
+        m_frame.windows++;
+        m_frame.windowBytes += m_windowBytes;
+        record(Window, cmd, m_windowBytes);
+        m_windowBytes = 0;
+        m_dataTarget = Memory;
+        return;
+    }
+    // Adresses suivies d'une autre commande (lecture RAMRD...) : coût de fenêtre quand même
+    m_frame.windowBytes += m_windowBytes;
+    m_windowBytes = 0;
+    m_dataTarget = Params;
+    record(Command, cmd, bytes);
+}
+
+void BusRecorder::add(Counters &total, const Counters &frame)
+{
+    total.frames += frame.frames;
+    total.transactions += frame.transactions;
+    total.commands += frame.commands;
+    total.windows += frame.windows;
+    total.dmaTransfers += frame.dmaTransfers;
+    total.bytes += frame.bytes;
+    total.pixelBytes += frame.pixelBytes;
+    total.windowBytes += frame.windowBytes;
+}
+
+void BusRecorder::endFrame(const char *view)
+{
+    m_frame.frames = 1;
+    portENTER_CRITICAL(&m_lock);
+    // Les noms de vue sont des constantes (getName()) : comparaison des pointeurs
+    ViewCounters *entry = nullptr;
+    for (int i = 0; i < m_viewCount; i++)
+    {
+        if (m_views[i].view == view)
+        {
+            entry = &m_views[i];
+            break;
+        }
+    }
+    if (entry == nullptr && m_viewCount < MAX_VIEWS)
+    {
+        entry = &m_views[m_viewCount++];
+        entry->view = view;
+        entry->counters = {};
+    }
+    if (entry != nullptr)
+        add(entry->counters, m_frame);
+    portEXIT_CRITICAL(&m_lock);
+    m_frame = {};
+}
+
+void BusRecorder::clear()
+{
+    portENTER_CRITICAL(&m_lock);
+    m_viewCount = 0;
+    m_eventCount = 0;
+    portEXIT_CRITICAL(&m_lock);
+}
+
+BusRecorder::Counters BusRecorder::viewCounters(const char *view) const
+{
+    Counters counters = {};
+    portENTER_CRITICAL(&m_lock);
+    for (int i = 0; i < m_viewCount; i++)
+    {
+        if (strcmp(m_views[i].view, view) == 0)
+            counters = m_views[i].counters;
+    }
+    portEXIT_CRITICAL(&m_lock);
+    return counters;
+}
+
+void BusRecorder::dump() const
+{
+    static ViewCounters views[MAX_VIEWS];
+    portENTER_CRITICAL(&m_lock);
+    int count = m_viewCount;
+    memcpy(views, m_views, count * sizeof(ViewCounters));
+    portEXIT_CRITICAL(&m_lock);
+
+    printf("LCD bus traffic per frame (%s, %.0f MHz)\n", m_target ? "pass-through" : "record only",
+           getClock() / 1000000.0f);
+    if (count == 0)
+        return;
+    printHeader();
+    for (int i = 0; i < count; i++)
+        printRow(views[i].view, views[i].counters, getClock());
+}
+
+void BusRecorder::printHeader()
+{
+    printf("%-12s %7s %9s %7s %7s %7s %9s %6s %9s %9s\n", "view", "frames", "bytes", "trans", "cmds", "windows",
+           "win bytes", "win %", "wire us", "win us");
+}
+
+// Moyennes par frame ; durées sur le fil estimées à la fréquence d'écriture (8 bits par octet)
+void BusRecorder::printRow(const char *view, const Counters &counters, uint32_t clockHz)
+{
+    if (counters.frames == 0)
+    {
+        printf("%-12s %7d\n", view, 0);
+        return;
+    }
+    const float clockMHz = clockHz / 1000000.0f;
+    float frames = (float)counters.frames;
+    float bytes = counters.bytes / frames;
+    float windowBytes = counters.windowBytes / frames;
+    printf("%-12s %7lu %9.0f %7.1f %7.1f %7.1f %9.1f %5.1f%% %9.0f %9.1f\n", view, (unsigned long)counters.frames,
+           bytes, counters.transactions / frames, counters.commands / frames, counters.windows / frames, windowBytes,
+           bytes > 0 ? 100.0f * windowBytes / bytes : 0.0f, bytes * 8 / clockMHz, windowBytes * 8 / clockMHz);
+}
+
+void BusRecorder::dumpEvents() const
+{
+    static Event events[RING_SIZE];
+    portENTER_CRITICAL(&m_lock);
+    uint32_t total = m_eventCount;
+    memcpy(events, m_ring, sizeof(m_ring));
+    portEXIT_CRITICAL(&m_lock);
+
+    uint32_t count = total < DUMP_EVENT_COUNT ? total : DUMP_EVENT_COUNT;
+    printf("Last %lu LCD bus events (%lu recorded)\n", (unsigned long)count, (unsigned long)total);
+    for (uint32_t i = total - count; i < total; i++)
+    {
+        const Event &event = events[i % RING_SIZE];
+        printf("%10lu us  %-6s 0x%02X %8lu bytes\n", (unsigned long)event.timeUs, eventName(event.kind),
+               event.value, (unsigned long)event.bytes);
+    }
+}
+
+int BusRecorder::command(int argc, char **argv)
+{
+    BusRecorder *self = s_instance;
+    if (self == nullptr)
+        return 1;
+
+    if (argc >= 2 && strcmp(argv[1], "clear") == 0)
+    {
+        self->clear();
+        printf("Bus statistics cleared\n");
+        return 0;
+    }
+    if (argc >= 2 && strcmp(argv[1], "log") == 0)
+    {
+        self->dumpEvents();
+        return 0;
+    }
+    if (argc >= 2)
+    {
+        printf("Usage: bus [clear|log]\n");
+        return 1;
+    }
+    self->dump();
+    return 0;
+}
+
+void BusRecorder::registerCommand()
+{
+    s_instance = this;
+
+    esp_console_cmd_t cmd = {};
+    cmd.command = "bus";
+    cmd.help = "LCD bus bytes, transactions and setWindow cost per frame and view. 'bus log' lists the last "
+               "bus events, 'bus clear' resets.";
+    cmd.hint = "[clear|log]";
+    cmd.func = &BusRecorder::command;
+    if (esp_console_cmd_register(&cmd) != ESP_OK)
+        ESP_LOGW("BusRecorder", "Console command registration failed");
+}
+
+// --- lgfx::IBus : comptage, puis relais au bus cible s'il y en a un ---
+
+void BusRecorder::release(void)
+{
+    if (m_target)
+        m_target->release();
+}
+
+void BusRecorder::setReadClock(uint32_t freq)
+{
+    if (m_target)
+        m_target->setReadClock(freq);
+}
+
+void BusRecorder::beginTransaction(void)
+{
+    m_frame.transactions++;
+    record(Transaction, 0, 0);
+    if (m_target)
+        m_target->beginTransaction();
+}
+
+void BusRecorder::endTransaction(void)
+{
+    if (m_target)
+        m_target->endTransaction();
+}
+
+void BusRecorder::wait(void)
+{
+    if (m_target)
+        m_target->wait();
+}
+
+void BusRecorder::initDMA(void)
+{
+    if (m_target)
+        m_target->initDMA();
+}
+
+void BusRecorder::addDMAQueue(const uint8_t *data, uint32_t length)
+{
+    m_dmaQueueBytes += length;
+    if (m_target)
+        m_target->addDMAQueue(data, length);
+}
+
+void BusRecorder::execDMAQueue(void)
+{
+    countData(m_dmaQueueBytes, true);
+    m_dmaQueueBytes = 0;
+    if (m_target)
+        m_target->execDMAQueue();
+}
+
+uint8_t *BusRecorder::getDMABuffer(uint32_t length)
+{
+    if (m_target)
+        return m_target->getDMABuffer(length);
+
+    // Deux buffers alternés, agrandis au besoin, comme ceux de Bus_SPI
+    m_dmaBufferIndex ^= 1;
+    int index = m_dmaBufferIndex;
+    if (m_dmaBufferSizes[index] < length)
+    {
+        uint8_t *buffer = (uint8_t *)realloc(m_dmaBuffers[index], length);
+        if (buffer == nullptr)
+            return nullptr;
+        m_dmaBuffers[index] = buffer;
+        m_dmaBufferSizes[index] = length;
+    }
+    return m_dmaBuffers[index];
+}
+
+void BusRecorder::flush(void)
+{
+    if (m_target)
+        m_target->flush();
+}
+
+bool BusRecorder::writeCommand(uint32_t data, uint_fast8_t bit_length)
+{
+    // En commandes 16 bits (dlen_16bit), le code est dans l'octet de poids fort
+    uint8_t cmd = (uint8_t)(bit_length > 8 ? data >> 8 : data);
+    countCommand(cmd, bit_length >> 3);
+    return m_target ? m_target->writeCommand(data, bit_length) : true;
+}
+
+void BusRecorder::writeData(uint32_t data, uint_fast8_t bit_length)
+{
+    countData(bit_length >> 3, false);
+    if (m_target)
+        m_target->writeData(data, bit_length);
+}
+
+void BusRecorder::writeDataRepeat(uint32_t data, uint_fast8_t bit_length, uint32_t count)
+{
+    countData((bit_length >> 3) * count, false);
+    if (m_target)
+        m_target->writeDataRepeat(data, bit_length, count);
+}
+
+void BusRecorder::writePixels(lgfx::pixelcopy_t *pc, uint32_t length)
+{
+    countData(length * (pc->dst_bits >> 3), false);
+    if (m_target)
+        m_target->writePixels(pc, length);
+}
+
+void BusRecorder::writeBytes(const uint8_t *data, uint32_t length, bool dc, bool use_dma)
+{
+    if (dc)
+        countData(length, use_dma);
+    else
+        countCommand(length > 0 ? data[0] : 0, length);
+    if (m_target)
+        m_target->writeBytes(data, length, dc, use_dma);
+}
+
+// Lectures relayées sans être comptées (l'écran du badge n'est pas relu)
+
+void BusRecorder::beginRead(uint_fast8_t dummy_bits)
+{
+    if (m_target)
+        m_target->beginRead(dummy_bits);
+}
+
+void BusRecorder::beginRead(void)
+{
+    if (m_target)
+        m_target->beginRead();
+}
+
+void BusRecorder::endRead(void)
+{
+    if (m_target)
+        m_target->endRead();
+}
+
+uint32_t BusRecorder::readData(uint_fast8_t bit_length)
+{
+    return m_target ? m_target->readData(bit_length) : 0;
+}
+
+bool BusRecorder::readBytes(uint8_t *dst, uint32_t length, bool use_dma)
+{
+    return m_target ? m_target->readBytes(dst, length, use_dma) : false;
+}
+
+void BusRecorder::readPixels(void *dst, lgfx::pixelcopy_t *pc, uint32_t length)
+{
+    if (m_target)
+        m_target->readPixels(dst, pc, length);
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstdint>
+
+#include "LovyanGFX.hpp"
+#include "freertos/FreeRTOS.h"
+
+// Bus LCD instrumenté : chaque commande, réglage de fenêtre (CASET / RASET / RAMWR) et écriture
+// de pixels est comptée et horodatée. Sans bus cible, rien n'est transmis (profil sur l'hôte
+// avec un Panel_ILI9341) ; avec setTarget(), tous les appels sont relayés au vrai bus
+// (Bus_SPI) : le profil est alors celui de la carte.
+// DisplayManager clôt une frame par endFrame() après chaque envoi : les octets, transactions et
+// fenêtres sont cumulés par vue, et la commande console "bus" les affiche.
+class BusRecorder : public lgfx::IBus
+{
+public:
+    enum EventKind : uint8_t
+    {
+        Transaction, // beginTransaction()
+        Command,     // Commande hors fenêtre (value : code)
+        Window,      // RAMWR : fin d'un réglage de fenêtre (bytes : octets de CASET / RASET / RAMWR)
+        Pixels,      // Écriture de pixels après RAMWR (bytes)
+        Data,        // Paramètres d'une autre commande (bytes)
+        Dma          // Lancement d'une file DMA (bytes)
+    };
+
+    struct Event
+    {
+        uint32_t timeUs; // esp_timer_get_time(), tronqué
+        uint32_t bytes;
+        uint8_t kind;
+        uint8_t value;
+    };
+
+    struct Counters
+    {
+        uint32_t frames;
+        uint32_t transactions;
+        uint32_t commands; // Toutes commandes, fenêtres comprises
+        uint32_t windows;
+        uint32_t dmaTransfers;
+        uint64_t bytes;       // Tout ce qui passe sur le bus (commandes, paramètres, pixels)
+        uint64_t pixelBytes;
+        uint64_t windowBytes; // Coût des setWindow : CASET, RASET, RAMWR et leurs adresses
+    };
+
+    static const int MAX_VIEWS = 8;
+    static const int RING_SIZE = 256;
+
+    ~BusRecorder();
+
+    // Bus relayé (nullptr : enregistrement seul). À appeler avant l'init() du panneau.
+    void setTarget(lgfx::IBus *target) { m_target = target; }
+
+    // Clôt la frame en cours de view ; le trafic depuis la frame précédente lui est attribué
+    void endFrame(const char *view);
+    void clear();
+    // Cumul d'une vue (compteurs à zéro si elle n'a envoyé aucune frame)
+    Counters viewCounters(const char *view) const;
+    // Compteurs par vue, ramenés à la frame, sur la sortie standard (console)
+    void dump() const;
+    // Derniers événements du bus, sur la sortie standard
+    void dumpEvents() const;
+    // En-tête et ligne du tableau de dump() (aussi utilisés par le benchmark hôte)
+    static void printHeader();
+    static void printRow(const char *view, const Counters &counters, uint32_t clockHz);
+
+    // Enregistre la commande console "bus" ; esp_console doit déjà être initialisé
+    void registerCommand();
+
+    // --- lgfx::IBus ---
+    lgfx::bus_type_t busType(void) const override { return m_target ? m_target->busType() : lgfx::bus_spi; }
+    bool init(void) override { return m_target ? m_target->init() : true; }
+    void release(void) override;
+    // Sans bus cible, fréquence supposée pour les durées estimées
+    uint32_t getClock(void) const override { return m_target ? m_target->getClock() : m_clock; }
+    void setClock(uint32_t freq) override;
+    uint32_t getReadClock(void) const override { return m_target ? m_target->getReadClock() : 0; }
+    void setReadClock(uint32_t freq) override;
+    void beginTransaction(void) override;
+    void endTransaction(void) override;
+    void wait(void) override;
+    bool busy(void) const override { return m_target ? m_target->busy() : false; }
+    void initDMA(void) override;
+    void addDMAQueue(const uint8_t *data, uint32_t length) override;
+    void execDMAQueue(void) override;
+    uint8_t *getDMABuffer(uint32_t length) override;
+    void flush(void) override;
+    bool writeCommand(uint32_t data, uint_fast8_t bit_length) override;
+    void writeData(uint32_t data, uint_fast8_t bit_length) override;
+    void writeDataRepeat(uint32_t data, uint_fast8_t bit_length, uint32_t count) override;
+    void writePixels(lgfx::pixelcopy_t *pc, uint32_t length) override;
+    void writeBytes(const uint8_t *data, uint32_t length, bool dc, bool use_dma) override;
+    using lgfx::IBus::readBytes;
+    void beginRead(uint_fast8_t dummy_bits) override;
+    void beginRead(void) override;
+    void endRead(void) override;
+    uint32_t readData(uint_fast8_t bit_length) override;
+    bool readBytes(uint8_t *dst, uint32_t length, bool use_dma) override;
+    void readPixels(void *dst, lgfx::pixelcopy_t *pc, uint32_t length) override;
+
+private:
+    // Rôle des données qui suivent la dernière commande
+    enum DataTarget : uint8_t
+    {
+        Params,
+        Address, // Après CASET / RASET
+        Memory   // Après RAMWR
+    };
+
+    struct ViewCounters
+    {
+        const char *view;
+        Counters counters;
+    };
+
+    void record(EventKind kind, uint8_t value, uint32_t bytes);
+    void countData(uint32_t bytes, bool dma);
+    void countCommand(uint8_t cmd, uint32_t bytes);
+    static void add(Counters &total, const Counters &frame);
+    static int command(int argc, char **argv);
+    static BusRecorder *s_instance;
+
+    lgfx::IBus *m_target = nullptr;
+    uint32_t m_clock = 40000000;
+    DataTarget m_dataTarget = Params;
+    uint32_t m_windowBytes = 0; // Octets du réglage de fenêtre en cours
+    uint32_t m_dmaQueueBytes = 0;
+    // Buffers DMA alternés de l'enregistrement seul (cf. IBus::getDMABuffer)
+    uint8_t *m_dmaBuffers[2] = {nullptr, nullptr};
+    uint32_t m_dmaBufferSizes[2] = {0, 0};
+    int m_dmaBufferIndex = 0;
+
+    mutable portMUX_TYPE m_lock = portMUX_INITIALIZER_UNLOCKED;
+    Counters m_frame = {};
+    ViewCounters m_views[MAX_VIEWS];
+    int m_viewCount = 0;
+    Event m_ring[RING_SIZE];
+    uint32_t m_eventCount = 0;
+};
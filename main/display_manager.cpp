@@ -4,12 +4,154 @@
 #include "esp_log.h"
 #include <cmath>
 #include <cstdio>
+#include <cstring>
 #include "driver/gpio.h"
+#include "driver/ledc.h"
+#include "esp_attr.h"
+#include "esp_heap_caps.h"
+#include "esp_sleep.h"
 #include <map>
+#include <algorithm>
 #include "config.h"
+#include "span_tracer.h"
+#include "touch_event.h"
 
 #define BUTTON_GPIO GPIO_NUM_0
+// Déplacement vertical (pixels) d'un Swipe qui bascule la rotation
+#define SWIPE_ROTATE_DISTANCE 50
+// Décalage vertical des coordonnées transmises aux vues quand l'écran est tourné de 180°
+#define ROTATED_TOUCH_OFFSET_Y 20
+// Délai après la sortie de veille du contrôleur (SLPOUT) avant la commande suivante
+#define PANEL_WAKEUP_DELAY_MS 10
+// Après un réveil de light sleep, délai laissé à la tâche d'entrée pour publier l'appui
+// avant d'envisager un nouveau light sleep
+#define LIGHT_SLEEP_GRACE_US 100000
+// Rétroéclairage (broche du Light_PWM de lgfx_custom.h) pendant la veille : canal LEDC basse
+// vitesse cadencé par RC_FAST (8 MHz), qui continue de tourner en light sleep, contrairement
+// au canal LovyanGFX cadencé par l'APB
+#define BACKLIGHT_GPIO GPIO_NUM_21
+#define SLEEP_BACKLIGHT_TIMER LEDC_TIMER_0
+#define SLEEP_BACKLIGHT_CHANNEL LEDC_CHANNEL_0
+#define SLEEP_BACKLIGHT_FREQ_HZ 25000
+// Sans attente entre les frames, un tick est cédé à la tâche idle à cette période au plus
+#define IDLE_YIELD_PERIOD_US 100000
+// dt maximal transmis aux vues (évite les sauts après une pause)
+#define MAX_FRAME_DT_US 100000
+// Pas fixes de simulation rattrapés au plus par frame ; au-delà le retard est abandonné
+#define MAX_UPDATE_STEPS 5
+// Période d'affichage des statistiques de l'horloge de frames
+#define FRAME_CLOCK_LOG_PERIOD_US 10000000
 #define LONG_PRESS_DURATION 2000
+// Nombre max de zones envoyées séparément (chaque zone coûte un setWindow)
+#define MAX_PUSH_REGIONS 8
+// Bandes de lignes renvoyées au plus pour des effets de lignes qui changent (scanlines qui
+// défilent : anciennes et nouvelles lignes) ; au-delà, la frame est envoyée entière
+#define MAX_EFFECT_ROWS 64
+// Surface perdue (pixels) tolérée pour fusionner deux zones en une seule
+#define DAMAGE_MERGE_SLACK 1024
+// Nombre max de bandes de tuiles envoyées avant de repasser en frame complète
+#define MAX_DIFF_RUNS 32
+// Période d'affichage des statistiques de tuiles (ms)
+#define FRAME_DIFF_LOG_PERIOD 10000
+// Mémoire max (octets) des frames compressées des vues statiques
+#define SNAPSHOT_CACHE_BUDGET (48 * 1024)
+// Cadence minimale pendant une transition entre vues
+#define TRANSITION_FPS 30
+// Mémoire max (octets) de la frame compressée de la vue quittée ; au-delà, pas de transition
+#define TRANSITION_FRAME_BUDGET (64 * 1024)
+// Part de la période de frame que le rendu peut occuper avant de baisser la qualité
+#define QUALITY_BUDGET_PERCENT 85
+// Hauteur (lignes) d'une bande en mode de rendu Banded : 2 bandes de 240 px restent sous 30 Ko
+#define BAND_HEIGHT 30
+// Tâches d'affichage : le rendu sur le cœur applicatif, l'envoi SPI sur l'autre
+#define RENDER_TASK_CORE 1
+#define PUSH_TASK_CORE 0
+#define DISPLAY_TASK_STACK 4096
+#define DISPLAY_TASK_PRIORITY 2
+// Au-dessus de la tâche d'envoi, sur le même cœur : Bus_SPI attend la fin des transferts en
+// scrutant le périphérique (pas d'interruption de fin de DMA), la tâche d'envoi ne rend donc
+// jamais la main d'elle-même. À priorité égale, la moitié basse attendait le prochain tick
+// (10 ms) pour être ordonnancée ; plus prioritaire, elle préempte l'attente dès sa notification.
+#define SPLIT_TASK_PRIORITY (DISPLAY_TASK_PRIORITY + 1)
+#define PUSH_QUEUE_LENGTH 4
+// La moitié haute d'un rendu parallèle fait un multiple de cette hauteur (cellules du plasma)
+#define SPLIT_ALIGN 4
+
+static int rectArea(const DamageRect &r)
+{
+    return r.w * r.h;
+}
+
+static DamageRect rectUnion(const DamageRect &a, const DamageRect &b)
+{
+    int x0 = std::min(a.x, b.x);
+    int y0 = std::min(a.y, b.y);
+    int x1 = std::max(a.x + a.w, b.x + b.w);
+    int y1 = std::max(a.y + a.h, b.y + b.h);
+    return {x0, y0, x1 - x0, y1 - y0};
+}
+
+// Surface ajoutée inutilement si on fusionne a et b (peut être négative en cas de chevauchement)
+static int mergeCost(const DamageRect &a, const DamageRect &b)
+{
+    return rectArea(rectUnion(a, b)) - rectArea(a) - rectArea(b);
+}
+
+// Regroupe les zones signalées par la vue en au plus maxOut rectangles à envoyer.
+// Retourne le nombre de rectangles, ou -1 si une frame complète est plus avantageuse.
+static int mergeDamage(const View &view, int screenW, int screenH, DamageRect *out, int maxOut)
+{
+    DamageRect rects[View::MAX_DAMAGE_RECTS];
+    int count = 0;
+
+    // Découper les zones à l'écran et ignorer les zones vides
+    for (int i = 0; i < view.damageCount(); i++)
+    {
+        const DamageRect &r = view.damageRect(i);
+        int x0 = std::max(r.x, 0);
+        int y0 = std::max(r.y, 0);
+        int x1 = std::min(r.x + r.w, screenW);
+        int y1 = std::min(r.y + r.h, screenH);
+        if (x1 > x0 && y1 > y0)
+            rects[count++] = {x0, y0, x1 - x0, y1 - y0};
+    }
+
+    // Fusion gloutonne : d'abord tout ce qui est quasi gratuit, puis le moins coûteux
+    // jusqu'à descendre sous maxOut
+    while (count > 1)
+    {
+        int bestI = 0, bestJ = 1;
+        int bestCost = mergeCost(rects[0], rects[1]);
+        for (int i = 0; i < count; i++)
+        {
+            for (int j = i + 1; j < count; j++)
+            {
+                int cost = mergeCost(rects[i], rects[j]);
+                if (cost < bestCost)
+                {
+                    bestCost = cost;
+                    bestI = i;
+                    bestJ = j;
+                }
+            }
+        }
+        if (bestCost > DAMAGE_MERGE_SLACK && count <= maxOut)
+            break;
+        rects[bestI] = rectUnion(rects[bestI], rects[bestJ]);
+        rects[bestJ] = rects[--count];
+    }
+
+    // Au-delà de 3/4 de l'écran, une seule transaction complète coûte moins cher
+    int total = 0;
+    for (int i = 0; i < count; i++)
+        total += rectArea(rects[i]);
+    if (total * 4 > screenW * screenH * 3)
+        return -1;
+
+    for (int i = 0; i < count; i++)
+        out[i] = rects[i];
+    return count;
+}
 
 // Met à jour la luminosité et applique immédiatement
 void DisplayManager::updateBrightness(uint8_t value)
@@ -27,7 +169,7 @@ void DisplayManager::updateAwakeTime(float minutes)
 }
 
 DisplayManager::DisplayManager(LGFX &lcd, AppState &state)
-    : m_lcd(lcd), m_state(state), m_sprite(&lcd)
+    : m_lcd(lcd), m_state(state), m_input(lcd), m_sprite(&lcd)
 {
     m_lastActivity = lgfx::v1::millis();
 }
@@ -36,165 +178,161 @@ void DisplayManager::init()
 {
     // Configuration du bouton GPIO 0 (BOOT)
     gpio_config_t io_conf = {};
-    io_conf.intr_type = GPIO_INTR_DISABLE;
+    io_conf.intr_type = GPIO_INTR_ANYEDGE;
     io_conf.mode = GPIO_MODE_INPUT;
     io_conf.pin_bit_mask = (1ULL << BUTTON_GPIO);
     io_conf.pull_down_en = GPIO_PULLDOWN_DISABLE;
     io_conf.pull_up_en = GPIO_PULLUP_ENABLE;
     gpio_config(&io_conf);
 
+    // Le bouton réveille la tâche de rendu bloquée (voir waitForNextEvent) ; le touch passe
+    // par la tâche d'entrée qui la notifie à chaque événement
+    gpio_install_isr_service(0);
+    gpio_isr_handler_add(BUTTON_GPIO, inputIsr, this);
+
     setBacklight(Config::activeBrightness);
     applyRotationFromConfig();
 
     m_state.screenW = m_lcd.width();
     m_state.screenH = m_lcd.height();
+    // Le sprite plein écran est créé à la première frame d'une vue FullFrame
     m_sprite.setColorDepth(16);
-    m_sprite.createSprite(m_state.screenW, m_state.screenH);
+    m_spriteRows.init(m_state.screenW);
+    m_spriteRows.setOverlay(&DisplayManager::spriteOverlay, this);
+    m_frameDiff.init(m_state.screenW, m_state.screenH);
+    m_snapshots.init(SNAPSHOT_CACHE_BUDGET);
+    m_transition.init(m_state.screenW);
+    m_postProcessor.init(m_state.screenW, m_state.screenH);
+
+    // Buffers de bandes (mémoire DMA) pour les vues en mode Banded
+    if (!m_bandFrames.create(m_state.screenW * sizeof(uint16_t), 2 * BAND_HEIGHT, BAND_HEIGHT))
+    {
+        ESP_LOGW("DisplayManager", "Band buffers allocation failed, banded rendering disabled");
+    }
+    m_bandCanvas.setColorDepth(16);
+    m_splitCanvas.setColorDepth(16);
 }
 
-void DisplayManager::displayLoop()
+void DisplayManager::renderTask(void *arg)
 {
-    if (!shouldRenderFrame())
-        return;
+    DisplayManager *self = static_cast<DisplayManager *>(arg);
+    // Le timer de frames et les interruptions d'entrée notifient cette tâche
+    self->m_renderTask = xTaskGetCurrentTaskHandle();
+    self->m_input.setListener(self->m_renderTask);
+    self->m_frameClock.init();
+    while (true)
+    {
+        self->displayLoop();
+    }
+}
 
-    unsigned long now = lgfx::v1::millis();
-    bool activity = false;
+void DisplayManager::pushTask(void *arg)
+{
+    DisplayManager *self = static_cast<DisplayManager *>(arg);
+    while (true)
+    {
+        self->pushLoop();
+    }
+}
+
+void DisplayManager::splitTask(void *arg)
+{
+    DisplayManager *self = static_cast<DisplayManager *>(arg);
+    while (true)
+    {
+        self->splitLoop();
+    }
+}
+
+void IRAM_ATTR DisplayManager::inputIsr(void *arg)
+{
+    DisplayManager *self = static_cast<DisplayManager *>(arg);
+    BaseType_t woken = pdFALSE;
+    if (self->m_renderTask)
+        vTaskNotifyGiveFromISR(self->m_renderTask, &woken);
+    portYIELD_FROM_ISR(woken);
+}
 
-    // Gérer le bouton
-    handleButton();
+void DisplayManager::start()
+{
+    if (!m_input.start())
+        ESP_LOGE("DisplayManager", "Touch input disabled");
 
-    int pixel_x = -1, pixel_y = -1;
-    int raw_x = -1, raw_y = -1;
-    m_lcd.getTouchRaw(&raw_x, &raw_y);
-    bool touchDetected = m_lcd.getTouch(&pixel_x, &pixel_y);
-    if (touchDetected)
+#if DISPLAY_SPLIT_RENDER
+    // La tâche auxiliaire tourne sur le cœur qui ne fait pas le rendu principal
+    m_splitDone = xSemaphoreCreateBinary();
+    if (m_splitDone == nullptr ||
+        xTaskCreatePinnedToCore(splitTask, "display_split", DISPLAY_TASK_STACK, this, SPLIT_TASK_PRIORITY, &m_splitTask, PUSH_TASK_CORE) != pdPASS)
     {
-        activity = true;
-        if (!m_wasTouched)
-        {
-            ESP_LOGI("DisplayManager", "Touch detected at (%d, %d)", pixel_x, pixel_y);
-            // Début du touch - sauvegarder les coordonnées
-            m_touchX = pixel_x;
-            m_touchY = pixel_y;
-            m_touchEndX = pixel_x;
-            m_touchEndY = pixel_y;
-            m_touchStartTime = now;
-            m_longPressTriggered = false;
-            m_wasTouched = true;
+        ESP_LOGW("DisplayManager", "Split render task creation failed, rendering on one core");
+        m_splitTask = nullptr;
+    }
+#endif
 
-            if (m_sleepMode)
-            {
-                // Quitter le mode veille sans changer de vue
-                m_sleepMode = false;
-                setBacklight(Config::activeBrightness);
-            }
-        }
-        else
+#if DISPLAY_DUAL_CORE
+    m_pushQueue = xQueueCreate(PUSH_QUEUE_LENGTH, sizeof(PushJob));
+    m_freeBands = xQueueCreate(2, sizeof(int));
+    m_spriteFree = xSemaphoreCreateBinary();
+    m_pushSync = xSemaphoreCreateBinary();
+    if (m_pushQueue != nullptr && m_freeBands != nullptr && m_spriteFree != nullptr && m_pushSync != nullptr)
+    {
+        // Au départ la tâche de rendu possède le sprite et les deux bandes
+        for (int i = 0; i < 2; i++)
         {
-            // Update end position for swipe detection
-            m_touchEndX = pixel_x;
-            m_touchEndY = pixel_y;
-            // Touch maintenu - vérifier pour appui long
-            unsigned long touchDuration = now - m_touchStartTime;
-            if (!m_longPressTriggered && touchDuration > 1000 && m_settings_view)
-            {
-                // Appui long détecté (> 1 seconde)
-                // Ne pas déclencher si on touche dans une zone interactive (comme la zone de caresse du chat)
-                bool inInteractiveZone = false;
-                if (m_currentView != nullptr)
-                {
-                    int test_x = pixel_x;
-                    int test_y = pixel_y;
-                    if (Config::display_rotated)
-                        test_y = test_y + 20;
-                    inInteractiveZone = m_currentView->isTouchInInteractiveZone(test_x, test_y);
-                }
+            xQueueSend(m_freeBands, &i, 0);
+        }
+        xSemaphoreGive(m_spriteFree);
 
-                m_longPressTriggered = true;
-                if (!inInteractiveZone && m_currentView != m_settings_view.get())
-                {
-                    ESP_LOGI("DisplayManager", "Long press detected - opening settings");
-                    // Aller aux réglages
-                    if (m_currentView != nullptr)
-                    {
-                        m_currentView->onExitView();
-                    }
-                    m_currentView = m_settings_view.get();
-                    m_currentView->setInitialRender(false);
-                    m_currentView->onEnterView();
-                }
-            }
+        xTaskCreatePinnedToCore(pushTask, "display_push", DISPLAY_TASK_STACK, this, DISPLAY_TASK_PRIORITY, NULL, PUSH_TASK_CORE);
+        xTaskCreatePinnedToCore(renderTask, "display_render", DISPLAY_TASK_STACK, this, DISPLAY_TASK_PRIORITY, NULL, RENDER_TASK_CORE);
+        return;
+    }
 
-            // Touch continu - continuer à envoyer les coordonnées à la vue
-            if (!m_views.empty() && !m_sleepMode && m_currentViewIdx < m_views.size())
-            {
-                if (Config::display_rotated)
-                {
-                    pixel_y = pixel_y + 20;
-                }
-                m_views[m_currentViewIdx]->handleTouch(pixel_x, pixel_y);
-            }
-        }
+    ESP_LOGW("DisplayManager", "Push queue allocation failed, falling back to a single display task");
+    if (m_pushQueue)
+        vQueueDelete(m_pushQueue);
+    if (m_freeBands)
+        vQueueDelete(m_freeBands);
+    if (m_spriteFree)
+        vSemaphoreDelete(m_spriteFree);
+    if (m_pushSync)
+        vSemaphoreDelete(m_pushSync);
+    m_pushQueue = nullptr;
+    m_freeBands = nullptr;
+    m_spriteFree = nullptr;
+    m_pushSync = nullptr;
+#endif
+    xTaskCreatePinnedToCore(renderTask, "display_loop", DISPLAY_TASK_STACK, this, DISPLAY_TASK_PRIORITY, NULL, RENDER_TASK_CORE);
+}
+
+void DisplayManager::displayLoop()
+{
+    {
+        TRACE_SCOPE("wait");
+        waitForNextEvent();
     }
-    else
+
+    unsigned long now = lgfx::v1::millis();
+    bool activity = false;
+
     {
-        // Touch relâché
-        if (m_wasTouched && !m_longPressTriggered && !m_sleepMode)
+        TRACE_SCOPE("input");
+        // Gérer le bouton
+        handleButton();
+        if (m_state.button_pressed)
         {
-            // C'était un clic court - traiter normalement
-            unsigned long touchDuration = now - m_touchStartTime;
-            if (touchDuration < 1000)
-            {
-                // Check for swipe up or down
-                int deltaX = m_touchEndX - m_touchX;
-                int deltaY = m_touchEndY - m_touchY;
-                bool isSwipe = (std::abs(deltaY) > 50) && (std::abs(deltaX) < std::abs(deltaY));
-                if (isSwipe)
-                {
-                    // Toggle rotation
-                    Config::setDisplayRotated(!Config::display_rotated);
-                    applyRotationFromConfig();
-                    ESP_LOGI("DisplayManager", "Swipe detected - toggling rotation");
-                }
-                else
-                {
-                    // Essayer de passer le touch à la vue courante
-                    bool touchHandled = false;
-                    if (m_currentView != nullptr)
-                    {
-                        int touch_x = m_touchX;
-                        int touch_y = m_touchY;
-                        if (Config::display_rotated)
-                        {
-                            // Ajuster les coordonnées touchées si l'écran est en rotation 180°
-                            touch_y = touch_y + 20;
-                        }
-                        ESP_LOGI("DisplayManager", "Passing touch at (%d, %d) to current view", touch_x, touch_y);
-                        touchHandled = m_currentView->handleTouch(touch_x, touch_y);
-                    }
-                    // Si la vue n'a pas géré le touch, changer de vue
-                    if (!touchHandled)
-                    {
-                        // si clic à gauche de l'écran, vue précédente, sinon suivante
-                        if (m_currentView == m_settings_view.get())
-                            nextView(0); // Retour de la vue réglages à la vue précédente
-                        else if (m_touchX < (m_state.screenW / 2))
-                            nextView(-1);
-                        else
-                            nextView();
-                    }
-                }
-            }
+            activity = true;
+            if (m_sleepMode)
+                exitSleep();
         }
 
-        // Plus de touch détecté - notifier la vue que le touch est terminé
-        if (m_wasTouched && !m_views.empty() && !m_sleepMode && m_currentViewIdx < m_views.size())
+        // Événements tactiles publiés par la tâche d'entrée
+        TouchEvent event;
+        while (m_input.poll(event))
         {
-            // Envoyer des coordonnées hors écran pour signaler la fin du touch
-            m_views[m_currentViewIdx]->handleTouch(-1, -1);
+            activity = true;
+            processTouchEvent(event);
         }
-        m_wasTouched = false;
-        m_longPressTriggered = false;
     }
 
     // Sortie de veille si bouton pressé
@@ -204,121 +342,1443 @@ void DisplayManager::displayLoop()
     // Entrée en veille après config.awakeTime minutes d'inactivité
     unsigned long awakeTimeMs = (unsigned long)(Config::awakeTime * 60.0f * 1000.0f);
     if (!m_sleepMode && (now - m_lastActivity > awakeTimeMs))
+        enterSleep();
+
+    // En veille le rendu est figé : la dernière frame reste affichée (ou en GRAM si l'écran dort)
+    if (m_currentView != nullptr && !m_sleepMode && frameDue(FrameClock::now()))
+        produceFrame();
+}
+
+// Affiche la vue index (changement de vue sans direction)
+void DisplayManager::showView(size_t index)
+{
+    if (index >= m_views.size())
+        return;
+    m_currentViewIdx = index;
+    switchView(m_views[index].get(), 0);
+}
+
+// Produit la frame due à nowUs sans attendre l'horloge de frames ni lire les entrées.
+// Retourne false si aucune frame n'était due.
+bool DisplayManager::stepFrame(int64_t nowUs)
+{
+    if (m_currentView == nullptr || !frameDue(nowUs))
+        return false;
+    produceFrame();
+    return true;
+}
+
+DisplayManager::FrameTiming DisplayManager::lastFrameTiming() const
+{
+    return {m_frameUpdateUs, m_frameRenderUs - m_frameUpdateUs, m_framePushUs};
+}
+
+// Rend et envoie la frame de la vue courante, puis contrôle son temps de rendu
+void DisplayManager::produceFrame()
+{
+    TRACE_SCOPE("frame");
+    m_frameRenderUs = 0;
+    m_frameUpdateUs = 0;
+    m_framePushUs = 0;
+    bool rendered = renderFrame();
+    checkFrameDeadlines();
+    // Frame sans envoi : l'entrée sera affichée par une frame suivante
+    if (m_frameInputUs != 0 && m_pendingInputUs == 0)
+        m_pendingInputUs = m_frameInputUs;
+    m_frameInputUs = 0;
+    if (rendered)
+        updateQuality();
+}
+
+// Produit et envoie une frame de la vue courante. Retourne true si la vue a été rendue
+// normalement (ni transition ni snapshot) : seul ce temps de rendu règle la qualité.
+bool DisplayManager::renderFrame()
+{
+    m_frameInputUs = m_pendingInputUs;
+    m_pendingInputUs = 0;
+
+    int64_t start = FrameClock::now();
     {
-        m_sleepMode = true;
-        setBacklight(Config::sleepBrightness);
+        TRACE_SCOPE("update");
+        runUpdates();
     }
+    m_frameUpdateUs = FrameClock::now() - start;
+    m_frameRenderUs += m_frameUpdateUs;
 
-    if (m_currentView != nullptr)
+    // Effets de lignes de la frame : ils ne s'appliquent que dans les bandes DMA. Le processeur
+    // voit chaque frame, même sans effets, pour comparer avec la précédente (changedRows)
+    RowEffects effects;
+    if (!m_currentView->rowEffects(effects))
+        effects = RowEffects();
+    m_postActive = m_postProcessor.begin(effects) && m_bandFrames.isInitialized();
+
+    if (m_transition.active())
     {
-        if (!m_currentView->needsRedraw() && m_currentView->hasInitialRender())
-        {
-            // Vue statique déjà rendue, ne rien faire
-            vTaskDelay(1);
-            return;
-        }
+        renderTransition();
+        return false;
+    }
+
+    // Retour sur une vue statique : sa dernière frame est réaffichée depuis le cache
+    if (!m_postActive && !m_currentView->hasInitialRender() && restoreSnapshot(m_currentView))
+    {
+        m_currentView->setInitialRender(true);
+        return false;
+    }
+
+    // Vue composée par couches : seules les zones modifiées sont recomposées et envoyées
+    if (m_currentView->layerCount() > 0 && renderLayered())
+    {
+        m_currentView->setInitialRender(true);
+        return true;
+    }
+
+    // Une vue en résolution réduite passe par son petit sprite, agrandi pendant l'envoi
+    bool scaled = spriteScale(m_currentView) > 1;
+    bool banded = !scaled && m_bandFrames.isInitialized() && m_currentView->renderMode() == RenderMode::Banded;
+    if (!prepareFrameBuffer(banded))
+    {
+        // Pas assez de mémoire pour le sprite : la vue est rendue par bandes malgré son coût
+        banded = m_bandFrames.isInitialized();
+        if (!banded)
+            return false;
+    }
 
-        // Sinon, rendre la vue normalement
-        m_currentView->render(m_lcd, m_sprite);
+    if (banded)
+    {
+        renderBanded();
         m_currentView->setInitialRender(true);
+        return true;
+    }
+
+    // Sinon, rendre la vue normalement
+    if (m_pushQueue)
+    {
+        // Le sprite est lu par la tâche d'envoi jusqu'à la fin de la frame précédente
+        TRACE_SCOPE("wait sprite");
+        xSemaphoreTake(m_spriteFree, portMAX_DELAY);
+    }
+    m_currentView->clearDamage();
+    renderView(m_currentView, m_sprite, m_sprite.getBuffer(), 0, m_sprite.height());
+    m_currentView->setInitialRender(true);
+    m_spriteView = m_currentView;
+    if (m_spriteScale > 1 || m_postActive)
+    {
+        pushConverted();
+        if (m_pushQueue)
+            xSemaphoreGive(m_spriteFree);
+    }
+    else if (m_pushQueue)
+    {
+        PushJob job = {};
+        job.type = PushJob::Frame;
+        job.view = m_currentView;
+        job.forceFull = consumeForceFullPush();
+        job.budgetUs = m_watchdog.budgetUs(frameRate());
+        job.inputUs = takeFrameInput();
+        xQueueSend(m_pushQueue, &job, portMAX_DELAY);
+    }
+    else
+    {
         // Attendre que les opérations SPI précédentes soient terminées
-        m_lcd.waitDisplay();
-        m_sprite.pushSprite(0, 0);
-        vTaskDelay(1);
+        waitDisplay();
+        int64_t start = FrameClock::now();
+        pushFrame(m_currentView, consumeForceFullPush());
+        waitDisplay();
+        m_framePushUs += FrameClock::now() - start;
+        m_watchdog.check(m_currentView->getName(), FrameWatchdog::Push, FrameClock::now() - start,
+                         m_watchdog.budgetUs(frameRate()));
+        framePushed(m_currentView, takeFrameInput());
     }
+    return true;
 }
-void DisplayManager::setBacklight(uint8_t percent)
+
+// Simulation de la vue courante avant son rendu : un update() avec le dt de la frame, ou
+// autant de pas fixes que le temps écoulé en contient (View::updateRate()). Le reste du
+// temps donne l'interpolation entre les deux derniers états pour render().
+void DisplayManager::runUpdates()
 {
-    // Clamp percent entre 0 et 100
-    if (percent > 100)
-        percent = 100;
-    // La méthode setBrightness attend une valeur entre 0 et 255
-    uint8_t value = (percent * 255) / 100;
-    m_lcd.setBrightness(value);
+    View *view = m_currentView;
+    int rate = view->updateRate();
+    if (rate <= 0)
+    {
+        view->update(m_state.dt);
+        view->setInterpolation(1.0f);
+        return;
+    }
+
+    int64_t step = 1000000 / rate;
+    m_updateAccumUs += m_frameElapsedUs;
+    // Rendu bloqué ou retour de veille : on ne rattrape que MAX_UPDATE_STEPS pas, la
+    // simulation ralentit au lieu d'enchaîner des pas qui retardent encore la frame
+    if (m_updateAccumUs > MAX_UPDATE_STEPS * step)
+        m_updateAccumUs = MAX_UPDATE_STEPS * step;
+
+    float dt = step * 0.000001f;
+    while (m_updateAccumUs >= step)
+    {
+        view->update(dt);
+        m_updateAccumUs -= step;
+    }
+    view->setInterpolation((float)m_updateAccumUs / step);
 }
 
-void DisplayManager::addView(std::unique_ptr<View> view)
+// Compare le temps de rendu de la frame au budget de la cadence de la vue et publie
+// le niveau de qualité dans AppState pour les frames suivantes
+void DisplayManager::updateQuality()
 {
-    m_views.push_back(std::move(view));
-    if (m_currentView == nullptr)
+    int fps = m_currentView->targetFps();
+    if (fps <= 0)
+        return;
+
+    int64_t budgetUs = 1000000 / fps * QUALITY_BUDGET_PERCENT / 100;
+    if (m_quality.record(m_frameRenderUs, budgetUs))
     {
-        m_currentView = m_views[0].get();
-        m_currentView->onEnterView();
+        ESP_LOGI("DisplayManager", "%s: quality %d (render %lld us, budget %lld us)", m_currentView->getName(),
+                 m_quality.level(), (long long)m_quality.averageUs(), (long long)budgetUs);
     }
+    m_state.quality = m_quality.level();
 }
 
-void DisplayManager::setSettingsView(std::unique_ptr<View> view)
+// Compare l'update et le rendu de la frame au budget de la cadence en cours (l'envoi est
+// vérifié par le côté envoi, voir pushLoop())
+void DisplayManager::checkFrameDeadlines()
 {
-    m_settings_view = std::move(view);
+    int32_t budgetUs = m_watchdog.budgetUs(frameRate());
+    const char *name = m_currentView->getName();
+    m_watchdog.check(name, FrameWatchdog::Update, m_frameUpdateUs, budgetUs);
+    m_watchdog.check(name, FrameWatchdog::Render, m_frameRenderUs - m_frameUpdateUs, budgetUs);
 }
 
-void DisplayManager::nextView(int direction)
+void DisplayManager::registerConsoleCommands()
 {
-    if (m_views.empty())
+    m_watchdog.registerCommand();
+    m_latency.registerCommand();
+    SpanTracer::registerCommand();
+    if (m_busRecorder)
+        m_busRecorder->registerCommand();
+}
+
+// La vue courante réagit à event : la prochaine frame envoyée clôt sa mesure de latence
+// (l'entrée la plus ancienne est gardée si plusieurs attendent la même frame)
+void DisplayManager::noteInputReaction(const TouchEvent &event)
+{
+    if (m_pendingInputUs == 0)
+        m_pendingInputUs = event.timeUs;
+}
+
+// Entrée à laquelle répond la frame en cours, transmise une seule fois avec son envoi
+int64_t DisplayManager::takeFrameInput()
+{
+    int64_t inputUs = m_frameInputUs;
+    m_frameInputUs = 0;
+    return inputUs;
+}
+
+// Fin de l'envoi d'une frame de view : mesure la latence de l'entrée à laquelle elle répond
+// et lui attribue le trafic du bus LCD depuis la frame précédente
+void DisplayManager::framePushed(const View *view, int64_t inputUs)
+{
+    if (inputUs != 0)
+        m_latency.record(view->getName(), FrameClock::now() - inputUs);
+    if (m_busRecorder)
+        m_busRecorder->endFrame(view->getName());
+}
+
+// Applique un événement tactile : veille, gestes globaux (réglages, rotation, navigation)
+// puis transmission à la vue courante
+void DisplayManager::processTouchEvent(const TouchEvent &event)
+{
+    if (event.type == TouchEvent::Down)
+    {
+        ESP_LOGI("DisplayManager", "Touch detected at (%d, %d)", event.x, event.y);
+        m_touchConsumed = false;
+        m_touchView = m_currentView;
+        if (m_sleepMode)
+        {
+            // Quitter le mode veille sans changer de vue : cet appui est consommé
+            exitSleep();
+            m_touchConsumed = true;
+        }
+    }
+
+    if (m_currentView == nullptr)
         return;
 
-    // Call onExitView on the current view if it exists
-    if (m_currentView != nullptr)
+    // Coordonnées vues par les vues : décalées si l'écran est tourné de 180°
+    TouchEvent viewEvent = event;
+    if (Config::display_rotated)
     {
-        m_currentView->onExitView();
+        viewEvent.y += ROTATED_TOUCH_OFFSET_Y;
+        viewEvent.startY += ROTATED_TOUCH_OFFSET_Y;
     }
 
-    m_currentViewIdx = (m_currentViewIdx + direction + m_views.size()) % m_views.size();
-    m_currentView = m_views[m_currentViewIdx].get();
-    m_currentView->setInitialRender(false);
+    // Appui commencé sur une autre vue (changée par l'appui long ou un clic) : seul le relâché
+    // lui revient, pour qu'elle ne reste pas appuyée
+    if (m_currentView != m_touchView)
+    {
+        if (event.type == TouchEvent::Up && m_touchView != nullptr)
+            m_touchView->handleTouchEvent(viewEvent);
+        return;
+    }
 
-    // Call onEnterView on the new view
-    m_currentView->onEnterView();
+    if (event.type == TouchEvent::LongPress && !m_touchConsumed)
+    {
+        // Ne pas ouvrir les réglages depuis une zone interactive (comme la zone de caresse du chat)
+        m_touchConsumed = true;
+        bool inInteractiveZone = m_currentView->isTouchInInteractiveZone(viewEvent.x, viewEvent.y);
+        if (m_settings_view && !inInteractiveZone && m_currentView != m_settings_view.get())
+        {
+            ESP_LOGI("DisplayManager", "Long press detected - opening settings");
+            switchView(m_settings_view.get(), 0);
+            noteInputReaction(event);
+            return;
+        }
+    }
+    else if ((event.type == TouchEvent::Tap || event.type == TouchEvent::Swipe) && !m_touchConsumed)
+    {
+        // Rotation, clic consommé par la vue ou changement de vue : toujours visible
+        handleClick(event, viewEvent);
+        noteInputReaction(event);
+        if (m_currentView != m_touchView)
+            return;
+    }
+
+    if (m_currentView->handleTouchEvent(viewEvent))
+    {
+        m_currentView->requestRedraw();
+        noteInputReaction(event);
+    }
 }
 
-bool DisplayManager::shouldRenderFrame()
+// Relâché rapide : un glissé vertical bascule la rotation, sinon clic à la position de départ
+void DisplayManager::handleClick(const TouchEvent &event, const TouchEvent &viewEvent)
 {
-    static unsigned long lastFrame = 0;
-    static bool firstFrame = true;
-
-    unsigned long now = lgfx::v1::millis();
-    unsigned long frameDurationMs = 1000 / m_targetFps;
+    int deltaX = event.x - event.startX;
+    int deltaY = event.y - event.startY;
+    if (std::abs(deltaY) > SWIPE_ROTATE_DISTANCE && std::abs(deltaX) < std::abs(deltaY))
+    {
+        // Toggle rotation
+        Config::setDisplayRotated(!Config::display_rotated);
+        applyRotationFromConfig();
+        ESP_LOGI("DisplayManager", "Swipe detected - toggling rotation");
+        return;
+    }
 
-    // Initialiser lors de la première frame
-    if (firstFrame)
+    // Essayer de passer le touch à la vue courante
+    ESP_LOGI("DisplayManager", "Passing touch at (%d, %d) to current view", viewEvent.startX, viewEvent.startY);
+    bool touchHandled = m_currentView->handleTouch(viewEvent.startX, viewEvent.startY);
+    if (touchHandled)
     {
-        lastFrame = now;
-        m_state.dt = 1.0f / m_targetFps; // Valeur par défaut pour la première frame
-        m_state.t = now * 0.001f;
-        firstFrame = false;
-        return true;
+        m_currentView->requestRedraw();
+        return;
     }
 
-    if ((now - lastFrame) < frameDurationMs)
+    // Si la vue n'a pas géré le touch, changer de vue :
+    // si clic à gauche de l'écran, vue précédente, sinon suivante
+    if (m_currentView == m_settings_view.get())
+        nextView(0); // Retour de la vue réglages à la vue précédente
+    else if (event.startX < (m_state.screenW / 2))
+        nextView(-1);
+    else
+        nextView();
+}
+
+void DisplayManager::pushLoop()
+{
+    PushJob job;
+    if (xQueueReceive(m_pushQueue, &job, portMAX_DELAY) != pdTRUE)
+        return;
+
+    switch (job.type)
     {
-        vTaskDelay(pdMS_TO_TICKS(1));
-        return false;
+    case PushJob::Frame:
+    {
+        int64_t start = FrameClock::now();
+        pushFrame(job.view, job.forceFull);
+        // Le sprite n'est rendu qu'une fois entièrement transmis
+        waitDisplay();
+        xSemaphoreGive(m_spriteFree);
+        m_watchdog.check(job.view->getName(), FrameWatchdog::Push, FrameClock::now() - start, job.budgetUs);
+        framePushed(job.view, job.inputUs);
+        break;
+    }
+    case PushJob::Band:
+        pushBand({job.x, job.y, job.w, job.h}, job.value, job.first, job.last);
+        if (job.last)
+        {
+            m_watchdog.check(job.view->getName(), FrameWatchdog::Push, FrameClock::now() - m_bandPushStartUs, job.budgetUs);
+            framePushed(job.view, job.inputUs);
+        }
+        break;
+    case PushJob::Rotation:
+        setPanelRotation(job.value);
+        break;
+    case PushJob::Sync:
+        xSemaphoreGive(m_pushSync);
+        break;
+    case PushJob::Measure:
+        m_measuredPushUs = pushSpriteTimed();
+        xSemaphoreGive(m_pushSync);
+        break;
     }
+}
 
-    // Calculer le delta time
-    m_state.dt = (now - lastFrame) * 0.001f; // Convertir en secondes
-    if (m_state.dt > 0.1f)                   // Limiter pour éviter les sauts
-        m_state.dt = 0.1f;
+// Attend la fin des transferts SPI en cours (span "waitDisplay" du traceur)
+void DisplayManager::waitDisplay()
+{
+    TRACE_SCOPE("waitDisplay");
+    m_lcd.waitDisplay();
+}
 
-    lastFrame = now;
-    m_state.t = now * 0.001f;
-    return true;
+// Attend que tous les travaux transmis à la tâche d'envoi soient terminés : le bus LCD
+// peut ensuite être utilisé depuis la tâche de rendu
+void DisplayManager::waitPushIdle()
+{
+    if (m_pushQueue == nullptr)
+    {
+        m_lcd.waitDisplay();
+        return;
+    }
+    // Les travaux sont traités dans l'ordre : quand Sync est atteint, tout le reste est envoyé
+    PushJob job = {};
+    job.type = PushJob::Sync;
+    xQueueSend(m_pushQueue, &job, portMAX_DELAY);
+    xSemaphoreTake(m_pushSync, portMAX_DELAY);
 }
 
-void DisplayManager::applyRotationFromConfig()
+// Envoi complet de m_sprite, chronométré jusqu'à la fin du DMA
+int64_t DisplayManager::pushSpriteTimed()
 {
-    m_lcd.waitDisplay(); // S'assurer que le LCD est prêt
+    TRACE_SCOPE("measure push");
+    int64_t start = FrameClock::now();
+    m_sprite.pushSprite(0, 0);
+    m_lcd.waitDisplay();
+    // L'écran ne correspond plus aux hash de la dernière frame envoyée
+    m_frameDiff.invalidate();
+    return FrameClock::now() - start;
+}
 
-    ESP_LOGI("DisplayManager", "Applying rotation: %d", Config::display_rotated);
+int64_t DisplayManager::measureSpritePush(const LGFX_Sprite &canvas)
+{
+    if (&canvas != &m_sprite || m_sprite.hasPalette() || m_spriteScale > 1 || m_postActive)
+        return -1;
+    if (m_pushQueue == nullptr)
+        return pushSpriteTimed();
 
-    if (Config::display_rotated)
+    // Le bus LCD appartient à la tâche d'envoi : l'envoi y passe après les travaux déjà en file
+    PushJob job = {};
+    job.type = PushJob::Measure;
+    xQueueSend(m_pushQueue, &job, portMAX_DELAY);
+    xSemaphoreTake(m_pushSync, portMAX_DELAY);
+    return m_measuredPushUs;
+}
+
+void DisplayManager::enterSleep()
+{
+    m_sleepMode = true;
+    setBacklight(Config::sleepBrightness);
+    ESP_LOGI("DisplayManager", "Entering sleep mode");
+
+    if (Config::sleepBrightness == 0)
     {
-        m_lcd.setRotation(2);
+        // Écran éteint : le contrôleur passe en veille (SLPIN), sa GRAM garde la dernière frame
+        waitPushIdle();
+        m_lcd.sleep();
+        m_panelAsleep = true;
     }
     else
     {
-        m_lcd.setRotation(0);
+        // Écran allumé : le contrôleur rafraîchit seul depuis sa GRAM, seul le rétroéclairage
+        // doit survivre au light sleep
+        startSleepBacklight(Config::sleepBrightness);
+    }
+}
+
+void DisplayManager::exitSleep()
+{
+    m_sleepMode = false;
+    if (m_panelAsleep)
+    {
+        // La GRAM est conservée : la dernière frame réapparaît sans être redessinée
+        m_lcd.wakeup();
+        vTaskDelay(pdMS_TO_TICKS(PANEL_WAKEUP_DELAY_MS));
+        m_panelAsleep = false;
     }
+    stopSleepBacklight();
+    setBacklight(Config::activeBrightness);
+    m_lastActivity = lgfx::v1::millis();
+    ESP_LOGI("DisplayManager", "Leaving sleep mode");
+}
+
+// Passe la broche du rétroéclairage sur le canal LEDC de veille, à percent %
+void DisplayManager::startSleepBacklight(uint8_t percent)
+{
+    ledc_timer_config_t timer = {};
+    timer.speed_mode = LEDC_LOW_SPEED_MODE;
+    timer.duty_resolution = LEDC_TIMER_8_BIT;
+    timer.timer_num = SLEEP_BACKLIGHT_TIMER;
+    timer.freq_hz = SLEEP_BACKLIGHT_FREQ_HZ;
+    timer.clk_cfg = LEDC_USE_RC_FAST_CLK;
+    ledc_channel_config_t channel = {};
+    channel.gpio_num = BACKLIGHT_GPIO;
+    channel.speed_mode = LEDC_LOW_SPEED_MODE;
+    channel.channel = SLEEP_BACKLIGHT_CHANNEL;
+    channel.intr_type = LEDC_INTR_DISABLE;
+    channel.timer_sel = SLEEP_BACKLIGHT_TIMER;
+    channel.duty = std::min<uint8_t>(percent, 100) * 255 / 100;
+    if (ledc_timer_config(&timer) != ESP_OK || ledc_channel_config(&channel) != ESP_OK)
+    {
+        // Le canal LovyanGFX garde la broche : le light sleep est évité (cf. lightSleepAllowed)
+        ESP_LOGW("DisplayManager", "Sleep backlight setup failed, staying out of light sleep");
+        return;
+    }
+    // RC_FAST reste alimenté pendant le light sleep tant que le canal l'utilise
+    esp_sleep_pd_config(ESP_PD_DOMAIN_RC_FAST, ESP_PD_OPTION_ON);
+    m_sleepBacklight = true;
+}
+
+// Rend la broche du rétroéclairage au canal LovyanGFX
+void DisplayManager::stopSleepBacklight()
+{
+    if (!m_sleepBacklight)
+        return;
+    if (lgfx::ILight *light = m_lcd.light())
+        light->init(0);
+    ledc_stop(LEDC_LOW_SPEED_MODE, SLEEP_BACKLIGHT_CHANNEL, 0);
+    esp_sleep_pd_config(ESP_PD_DOMAIN_RC_FAST, ESP_PD_OPTION_AUTO);
+    m_sleepBacklight = false;
+}
+
+// Light sleep possible : en veille avec un rétroéclairage qui y survit, hors du délai qui suit
+// un réveil, et sans doigt ni bouton encore posé (le réveil est sur niveau : ils réveilleraient
+// aussitôt le SoC, avant que la tâche d'entrée ait pu publier l'appui)
+bool DisplayManager::lightSleepAllowed(int64_t now) const
+{
+    return m_sleepMode && (m_panelAsleep || m_sleepBacklight) && now >= m_lightSleepWakeUs + LIGHT_SLEEP_GRACE_US &&
+           !m_input.isPressed() && !m_input.isPenDown() && gpio_get_level(BUTTON_GPIO) != 0;
+}
+
+// Met le SoC en light sleep jusqu'à un appui (T_IRQ ou BOOT à l'état bas)
+void DisplayManager::lightSleepUntilInput()
+{
+    // La tâche d'envoi (cœur 0) peut encore transférer la dernière frame : le light sleep
+    // couperait le DMA en cours, quel que soit l'état du panneau
+    waitPushIdle();
+
+    // Le réveil GPIO est sur niveau : les interruptions sur front sont coupées pendant
+    // la veille pour ne pas boucler dans l'ISR tant que le niveau reste bas
+    gpio_intr_disable(BUTTON_GPIO);
+    gpio_wakeup_enable(BUTTON_GPIO, GPIO_INTR_LOW_LEVEL);
+    m_input.enableSleepWakeup();
+    esp_sleep_enable_gpio_wakeup();
+
+    esp_light_sleep_start();
+
+    gpio_wakeup_disable(BUTTON_GPIO);
+    gpio_set_intr_type(BUTTON_GPIO, GPIO_INTR_ANYEDGE);
+    gpio_intr_enable(BUTTON_GPIO);
+    m_input.disableSleepWakeup();
+}
+
+bool DisplayManager::consumeForceFullPush()
+{
+    bool force = m_forceFullPush;
+    m_forceFullPush = false;
+    return force;
+}
+
+void DisplayManager::renderBanded()
+{
+    const int width = m_state.screenW;
+    const int height = m_state.screenH;
+
+    // Le snapshot éventuel de la vue ne correspond plus à ce qui est affiché
+    m_snapshots.invalidate(m_currentView);
+
+    sendBands([&](uint16_t *band, int y, int h) {
+        // Le canvas couvre tout l'écran mais son buffer est décalé pour que la ligne y
+        // tombe au début de la bande : le clip garantit qu'aucun pixel hors bande n'est écrit,
+        // les vues dessinent donc en coordonnées écran sans modification.
+        m_bandCanvas.setBuffer(band - y * width, width, height, 16);
+        renderView(m_currentView, m_bandCanvas, band - y * width, y, h);
+        if (m_postActive)
+            m_postProcessor.apply(band, y, h);
+    });
+}
+
+// Envoie une bande pleine largeur remplie (directement ou via la tâche d'envoi)
+void DisplayManager::submitBand(int y, int h, int buffer)
+{
+    submitRegion({0, y, m_state.screenW, h}, buffer, y == 0, y + h >= m_state.screenH);
+}
+
+// Envoie une frame complète, bande par bande : fill(band, y, h) remplit les lignes [y, y + h)
+// dans le buffer de bande. Tout l'écran étant réécrit, un envoi complet demandé est satisfait.
+template <typename Fill>
+void DisplayManager::sendBands(Fill fill)
+{
+    m_forceFullPush = false;
+    for (int y = 0; y < m_state.screenH; y += BAND_HEIGHT)
+    {
+        int h = std::min(BAND_HEIGHT, m_state.screenH - y);
+        int buffer = acquireBand();
+        fill(bandBuffer(buffer), y, h);
+        submitBand(y, h, buffer);
+    }
+}
+
+// Envoie une zone rangée dans un buffer de bande (area.w pixels par ligne). first et last
+// encadrent les zones d'une même frame.
+void DisplayManager::submitRegion(const DamageRect &area, int buffer, bool first, bool last)
+{
+    if (m_pushQueue)
+    {
+        PushJob job = {};
+        job.type = PushJob::Band;
+        job.view = m_currentView;
+        job.value = (uint8_t)buffer;
+        job.first = first;
+        job.last = last;
+        job.x = (int16_t)area.x;
+        job.y = (int16_t)area.y;
+        job.w = (int16_t)area.w;
+        job.h = (int16_t)area.h;
+        job.budgetUs = m_watchdog.budgetUs(frameRate());
+        if (last)
+            job.inputUs = takeFrameInput();
+        xQueueSend(m_pushQueue, &job, portMAX_DELAY);
+    }
+    else
+    {
+        int64_t start = FrameClock::now();
+        pushBand(area, buffer, first, last);
+        m_framePushUs += FrameClock::now() - start;
+        if (last)
+        {
+            m_watchdog.check(m_currentView->getName(), FrameWatchdog::Push, FrameClock::now() - m_bandPushStartUs,
+                             m_watchdog.budgetUs(frameRate()));
+            framePushed(m_currentView, takeFrameInput());
+        }
+    }
+}
+
+// Frame de transition : la vue entrante (snapshot, sprite ou rendu par bande) est composée
+// bande par bande avec la frame capturée de la vue quittée, puis envoyée
+void DisplayManager::renderTransition()
+{
+    View *view = m_currentView;
+    const int width = m_state.screenW;
+    const int height = m_state.screenH;
+    bool last = m_transition.advance(FrameClock::now());
+
+    // Une vue statique redessinée pendant la transition n'est plus affichée depuis son snapshot
+    if (m_redrawPending)
+        m_transitionSnapshot = nullptr;
+
+    const SnapshotCache::Snapshot *snapshot = m_transitionSnapshot;
+    bool fromSprite = false;
+    bool fullLayers = !view->hasInitialRender();
+    bool fromLayers = snapshot == nullptr && view->layerCount() > 0 && renderLayers(view, fullLayers);
+    if (snapshot == nullptr && !fromLayers)
+    {
+        fromSprite = (view->renderMode() == RenderMode::FullFrame || spriteScale(view) > 1) && prepareFrameBuffer(false);
+        if (!fromSprite)
+            prepareFrameBuffer(true);
+    }
+
+    if (fromSprite)
+    {
+        // Le sprite est lu par la tâche d'envoi jusqu'à la fin de la frame précédente
+        if (m_spriteFree)
+            xSemaphoreTake(m_spriteFree, portMAX_DELAY);
+        // Une vue statique déjà rendue dans le sprite n'est pas redessinée
+        if (m_spriteView != view || view->targetFps() > 0 || m_redrawPending)
+        {
+            view->clearDamage();
+            renderView(view, m_sprite, m_sprite.getBuffer(), 0, m_sprite.height());
+            m_spriteView = view;
+        }
+    }
+
+    m_transition.beginFrame();
+    size_t offset = 0;
+    sendBands([&](uint16_t *band, int y, int h) {
+        const uint16_t *incoming = band;
+        if (snapshot != nullptr)
+        {
+            offset = SnapshotCache::decodeRows(*snapshot, offset, band, h);
+        }
+        else if (fromSprite || fromLayers)
+        {
+            // Lignes du sprite 16 bits, ou reconstruites (palette, couches) dans la bande
+            incoming = m_spriteRows.rows(y, h, band);
+        }
+        else
+        {
+            m_bandCanvas.setBuffer(band - y * width, width, height, 16);
+            renderView(view, m_bandCanvas, band - y * width, y, h);
+        }
+        if (m_postActive)
+        {
+            // Les effets ne modifient que la bande, jamais le sprite
+            if (incoming != band)
+                memcpy(band, incoming, width * h * sizeof(uint16_t));
+            m_postProcessor.apply(band, y, h);
+            incoming = band;
+        }
+        m_transition.composeRows(incoming, band, h);
+    });
+
+    // Les bandes ne référencent pas le sprite : il est libre dès la composition terminée
+    if (fromSprite && m_spriteFree)
+        xSemaphoreGive(m_spriteFree);
+
+    view->setInitialRender(true);
+    if (last)
+    {
+        m_transition.end();
+        m_transitionSnapshot = nullptr;
+        // Rendue par bandes, la vue n'a plus de snapshot à jour (supprimé seulement maintenant :
+        // la transition gardait des pointeurs vers le cache)
+        if (snapshot == nullptr && !fromSprite && !fromLayers)
+            m_snapshots.invalidate(view);
+    }
+}
+
+// Envoie le sprite en entier via les bandes DMA : ses lignes y sont agrandies (sprite de
+// résolution réduite) ou recopiées, puis les effets de lignes de la vue sont appliqués
+void DisplayManager::pushConverted()
+{
+    TRACE_SCOPE("convert");
+    sendBands([&](uint16_t *band, int y, int h) {
+        const uint16_t *rows = m_spriteRows.rows(y, h, band);
+        if (rows != band)
+            memcpy(band, rows, m_state.screenW * h * sizeof(uint16_t));
+        if (m_postActive)
+            m_postProcessor.apply(band, y, h);
+    });
+}
+
+// Surcouche pleine résolution de la vue du sprite agrandi, sur ses lignes reconstruites
+// [y, y + h) (envoi, transitions, snapshots). Même décalage de buffer que renderBanded.
+void DisplayManager::spriteOverlay(void *arg, uint16_t *rows, int y, int h)
+{
+    DisplayManager *self = (DisplayManager *)arg;
+    if (self->m_spriteView == nullptr)
+        return;
+    int64_t start = FrameClock::now();
+    const int width = self->m_state.screenW;
+    LGFX_Sprite &canvas = self->m_bandCanvas;
+    canvas.setBuffer(rows - y * width, width, self->m_state.screenH, 16);
+    canvas.setClipRect(0, y, width, h);
+    self->m_spriteView->renderOverlay(canvas);
+    canvas.clearClipRect();
+    self->m_frameRenderUs += FrameClock::now() - start;
+}
+
+// Crée les couches de la vue à la place du sprite plein écran. fresh indique des couches
+// nouvellement créées (à redessiner entièrement). Retourne false si la mémoire manque :
+// la vue est alors rendue par render() comme les autres.
+bool DisplayManager::prepareLayers(View *view, bool &fresh)
+{
+    fresh = false;
+    if (m_layers.view() == view)
+        return true;
+    if (!m_bandFrames.isInitialized() || m_layersAllocFailed)
+        return false;
+
+    // Libère le sprite (et les couches d'une autre vue) avant d'allouer les couches
+    prepareFrameBuffer(true);
+    if (!m_layers.allocate(view, m_state.screenW, m_state.screenH))
+    {
+        ESP_LOGW("DisplayManager", "Layer allocation failed, rendering %s without compositing", view->getName());
+        m_layersAllocFailed = true;
+        return false;
+    }
+    // Marge restante : les buffers des snapshots et des transitions doivent encore y tenir
+    ESP_LOGI("DisplayManager", "%s: %d layers (%u bytes), heap free %u, largest block %u", view->getName(),
+             m_layers.count(), (unsigned)m_layers.bytes(), (unsigned)heap_caps_get_free_size(MALLOC_CAP_8BIT),
+             (unsigned)heap_caps_get_largest_free_block(MALLOC_CAP_8BIT));
+    m_spriteRows.attach(&m_layers, m_state.screenW, m_state.screenH);
+    fresh = true;
+    return true;
+}
+
+// Met à jour les couches de la vue : chaque couche redessine ce qui a changé (zones signalées
+// via addDamage), ou tout si full (passé à true pour des couches nouvellement créées), puis
+// les palettes sont relues. Retourne false sans couches.
+bool DisplayManager::renderLayers(View *view, bool &full)
+{
+    bool fresh = false;
+    if (!prepareLayers(view, fresh))
+        return false;
+    full = full || fresh;
+
+    int64_t start = FrameClock::now();
+    view->clearDamage();
+    for (int i = 0; i < m_layers.count(); i++)
+        view->renderLayer(i, m_layers.layer(i), full);
+    m_layers.updatePalettes();
+    m_frameRenderUs += FrameClock::now() - start;
+
+    // La frame affichée se relit désormais depuis les couches (snapshots, transitions)
+    m_spriteView = view;
+    return true;
+}
+
+// Frame d'une vue composée par couches : seules les zones modifiées d'au moins une couche
+// sont recomposées dans les bandes DMA et envoyées
+bool DisplayManager::renderLayered()
+{
+    View *view = m_currentView;
+    bool full = !view->hasInitialRender() || m_forceFullPush;
+    if (!renderLayers(view, full))
+        return false;
+
+    const int width = m_state.screenW;
+    const int height = m_state.screenH;
+    // Zones de la vue, puis lignes dont les effets ont changé (scanlines qui défilent)
+    DamageRect areas[MAX_PUSH_REGIONS + MAX_EFFECT_ROWS];
+    int count = -1;
+    if (!full && !view->hasFullDamage())
+        count = mergeDamage(*view, width, height, areas, MAX_PUSH_REGIONS);
+    if (count >= 0 && m_postActive)
+        count = addEffectRows(areas, count, MAX_EFFECT_ROWS);
+    if (count < 0)
+    {
+        areas[0] = {0, 0, width, height};
+        count = 1;
+    }
+    m_forceFullPush = false;
+
+    if (count > 0)
+    {
+        int64_t start = FrameClock::now();
+        pushLayers(areas, count);
+        m_frameRenderUs += FrameClock::now() - start;
+    }
+    return true;
+}
+
+// Ajoute aux count zones de areas les lignes dont les effets ont changé depuis la frame
+// précédente, sauf celles déjà couvertes par une zone pleine largeur. Retourne le nouveau
+// nombre de zones, ou -1 s'il faut envoyer toute la frame.
+int DisplayManager::addEffectRows(DamageRect *areas, int count, int maxRows)
+{
+    DamageRect *rows = areas + count;
+    int rowCount = m_postProcessor.changedRows(rows, maxRows);
+    if (rowCount < 0)
+        return -1;
+
+    int kept = 0;
+    for (int i = 0; i < rowCount; i++)
+    {
+        const DamageRect &row = rows[i];
+        bool covered = false;
+        for (int j = 0; j < count && !covered; j++)
+        {
+            const DamageRect &area = areas[j];
+            covered = area.x == 0 && area.w == m_state.screenW && area.y <= row.y && row.y + row.h <= area.y + area.h;
+        }
+        if (!covered)
+            rows[kept++] = row;
+    }
+    return count + kept;
+}
+
+// Compose les zones dans les bandes DMA, par blocs de lignes qui tiennent dans une bande,
+// et les envoie au fur et à mesure
+void DisplayManager::pushLayers(const DamageRect *areas, int count)
+{
+    TRACE_SCOPE("compose");
+    const int bandPixels = m_state.screenW * BAND_HEIGHT;
+    for (int i = 0; i < count; i++)
+    {
+        const DamageRect &area = areas[i];
+        int rows = std::max(1, bandPixels / area.w);
+        for (int y = area.y; y < area.y + area.h; y += rows)
+        {
+            DamageRect block = {area.x, y, area.w, std::min(rows, area.y + area.h - y)};
+            int buffer = acquireBand();
+            uint16_t *band = bandBuffer(buffer);
+            m_layers.compose(block.x, block.y, block.w, block.h, band);
+            if (m_postActive)
+                m_postProcessor.apply(band, block.x, block.y, block.w, block.h);
+            bool first = i == 0 && y == area.y;
+            bool last = i == count - 1 && y + block.h >= area.y + area.h;
+            submitRegion(block, buffer, first, last);
+        }
+    }
+}
+
+// Facteur de réduction du sprite de la vue : l'agrandissement passe par les bandes DMA
+int DisplayManager::spriteScale(const View *view) const
+{
+    if (!m_bandFrames.isInitialized())
+        return 1;
+    int scale = view->renderScale();
+    return scale > 1 && m_state.screenW % scale == 0 && m_state.screenH % scale == 0 ? scale : 1;
+}
+
+// Compresse la frame de la vue quittée si le sprite la contient encore. Le sprite peut être
+// lu en même temps par la tâche d'envoi : les deux ne font que le lire.
+void DisplayManager::captureSnapshot()
+{
+    if (m_currentView == nullptr || m_spriteView != m_currentView || !m_currentView->usesSnapshotCache())
+        return;
+    m_snapshots.store(m_currentView, m_spriteRows);
+}
+
+// Réaffiche la frame gardée en cache : décompression ligne à ligne dans les bandes DMA
+// puis envoi SPI, sans render(). Retourne false s'il faut rendre la vue.
+bool DisplayManager::restoreSnapshot(View *view)
+{
+    if (!m_bandFrames.isInitialized() || !view->usesSnapshotCache())
+        return false;
+    const SnapshotCache::Snapshot *snapshot = m_snapshots.find(view);
+    if (snapshot == nullptr || snapshot->width != m_state.screenW || snapshot->height != m_state.screenH)
+        return false;
+
+    size_t offset = 0;
+    sendBands([&](uint16_t *band, int y, int h) { offset = SnapshotCache::decodeRows(*snapshot, offset, band, h); });
+    return true;
+}
+
+// Rend les lignes [y, y + h) de la vue dans canvas, dont le buffer plein écran est buffer.
+// Si la vue le permet, la moitié basse est dessinée en parallèle par la tâche auxiliaire
+// dans un second sprite partageant le même buffer.
+void DisplayManager::renderView(View *view, LGFX_Sprite &canvas, void *buffer, int y, int h)
+{
+    TRACE_SCOPE("render");
+    // Temps de rendu cumulé sur la frame (les bandes d'une vue Banded s'additionnent)
+    int64_t start = FrameClock::now();
+    const int width = canvas.width();
+    int topH = (h / 2) & ~(SPLIT_ALIGN - 1);
+    if (m_splitTask == nullptr || !view->supportsSplitRender() || canvas.hasPalette() || topH == 0)
+    {
+        canvas.setClipRect(0, y, width, h);
+        view->render(m_lcd, canvas);
+        canvas.clearClipRect();
+        m_frameRenderUs += FrameClock::now() - start;
+        return;
+    }
+
+    m_splitCanvas.setBuffer(buffer, width, canvas.height(), 16);
+    m_splitCanvas.setClipRect(0, y + topH, width, h - topH);
+    m_splitView = view;
+    xTaskNotifyGive(m_splitTask);
+
+    canvas.setClipRect(0, y, width, topH);
+    view->render(m_lcd, canvas);
+    canvas.clearClipRect();
+
+    // Attendre la moitié basse avant de rendre la main (envoi ou bande suivante).
+    // Un sémaphore plutôt qu'une notification : celles de la tâche de rendu viennent des entrées.
+    xSemaphoreTake(m_splitDone, portMAX_DELAY);
+    m_frameRenderUs += FrameClock::now() - start;
+}
+
+void DisplayManager::splitLoop()
+{
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    TRACE_SCOPE("render");
+    m_splitView->render(m_lcd, m_splitCanvas);
+    xSemaphoreGive(m_splitDone);
+}
+
+// Alloue ou libère le sprite plein écran selon le mode de la vue courante.
+// Retourne false si le sprite est nécessaire mais n'a pas pu être alloué.
+bool DisplayManager::prepareFrameBuffer(bool banded)
+{
+    View *view = m_currentView;
+    int bits = view->colorDepth();
+    int scale = spriteScale(view);
+    bool hasSprite = m_sprite.getBuffer() != nullptr;
+    if (m_layers.view() != nullptr)
+    {
+        // Les couches ne sont utilisées que par leur vue : la mémoire revient au sprite ou aux bandes
+        m_layers.release();
+        m_spriteRows.detach();
+        m_spriteView = nullptr;
+        ESP_LOGI("DisplayManager", "Layers released");
+    }
+    if (banded ? !hasSprite
+               : (hasSprite && bits == m_spriteBits && scale == m_spriteScale && (bits == 16 || m_paletteView == view)))
+        return true;
+    if (!banded && m_spriteAllocFailed)
+        return false;
+
+    // La tâche d'envoi peut encore lire le sprite de la dernière frame
+    if (m_spriteFree)
+        xSemaphoreTake(m_spriteFree, portMAX_DELAY);
+
+    m_spriteView = nullptr;
+    m_paletteView = nullptr;
+    m_spriteRows.detach();
+    if (banded)
+    {
+        m_sprite.deleteSprite();
+        ESP_LOGI("DisplayManager", "Full-frame sprite released");
+    }
+    else
+    {
+        if (!hasSprite || bits != m_spriteBits || scale != m_spriteScale)
+        {
+            // Un sprite à palette de 4 bits ou en demi-résolution occupe 4 fois moins de RAM.
+            // Sans buffer, setColorDepth() garde la palette d'une vue précédente : supprimée ici.
+            m_sprite.deleteSprite();
+            m_sprite.deletePalette();
+            m_sprite.setColorDepth(bits);
+            m_spriteBits = bits;
+            m_spriteScale = scale;
+            int width = m_state.screenW / scale;
+            int height = m_state.screenH / scale;
+            if (m_sprite.createSprite(width, height) != nullptr)
+            {
+                m_forceFullPush = true;
+                ESP_LOGI("DisplayManager", "Full-frame sprite %dx%d %d bpp (%d bytes)", width, height, bits,
+                         width * height * bits / 8);
+            }
+            else
+            {
+                ESP_LOGW("DisplayManager", "Full-frame sprite allocation failed, rendering %s in bands", view->getName());
+                m_spriteAllocFailed = true;
+            }
+        }
+
+        if (!m_spriteAllocFailed)
+        {
+            const uint16_t *lut = nullptr;
+            if (bits < 16)
+            {
+                // Palette de la vue : dans le sprite pour l'envoi, et en RGB565 octets
+                // inversés pour relire les lignes (snapshots, transitions)
+                int count = 0;
+                const uint16_t *colors = view->palette(count);
+                count = std::min(count, 1 << bits);
+                m_sprite.createPalette(colors, count);
+                for (int i = 0; i < (1 << bits); i++)
+                {
+                    uint16_t c = i < count ? colors[i] : 0;
+                    m_paletteLut[i] = (uint16_t)((c >> 8) | (c << 8));
+                }
+                lut = m_paletteLut;
+                m_paletteView = view;
+            }
+            m_spriteRows.attach(m_sprite.getBuffer(), m_state.screenW, m_state.screenH, bits, lut, m_spriteScale);
+        }
+    }
+
+    if (m_spriteFree)
+        xSemaphoreGive(m_spriteFree);
+    return banded || !m_spriteAllocFailed;
+}
+
+// Côté rendu : obtient un buffer de bande que le DMA ne lit plus
+int DisplayManager::acquireBand()
+{
+    if (m_freeBands)
+    {
+        TRACE_SCOPE("wait band");
+        int buffer = 0;
+        xQueueReceive(m_freeBands, &buffer, portMAX_DELAY);
+        return buffer;
+    }
+
+    // Une seule tâche : pushBand a attendu le DMA de l'avant-dernière bande,
+    // seul l'autre buffer peut encore être en cours d'envoi
+    int buffer = m_bandIndex;
+    m_bandIndex ^= 1;
+    return buffer;
+}
+
+void DisplayManager::releaseBand(int buffer)
+{
+    if (buffer >= 0 && m_freeBands)
+        xQueueSend(m_freeBands, &buffer, 0);
+}
+
+// Côté envoi : lance le DMA d'une bande rendue
+void DisplayManager::pushBand(const DamageRect &area, int buffer, bool first, bool last)
+{
+    TRACE_SCOPE("push band");
+    if (first)
+    {
+        m_bandPushStartUs = FrameClock::now();
+        // L'écran est réécrit sans passer par le sprite : les hash de tuiles ne lui correspondent plus
+        m_frameDiff.invalidate();
+        m_lcd.startWrite();
+    }
+
+    // On attend seulement la fin du DMA de la bande précédente avant de lancer celle-ci,
+    // son buffer redevient alors disponible pour le rendu
+    m_lcd.waitDMA();
+    releaseBand(m_pendingBand);
+    m_lcd.pushImageDMA(area.x, area.y, area.w, area.h, (const lgfx::swap565_t *)bandBuffer(buffer));
+    m_pendingBand = buffer;
+
+    if (last)
+    {
+        m_lcd.waitDMA();
+        releaseBand(m_pendingBand);
+        m_pendingBand = -1;
+        m_lcd.endWrite();
+    }
+}
+
+void DisplayManager::pushFrame(View *view, bool forceFull)
+{
+    TRACE_SCOPE("push");
+    if (!view->reportsDamage())
+    {
+        pushFrameDiff(view, forceFull);
+        return;
+    }
+
+    // Les hash de tuiles ne suivent pas les envois partiels des vues à zones signalées
+    m_frameDiff.invalidate();
+    if (forceFull || view->hasFullDamage())
+    {
+        m_sprite.pushSprite(0, 0);
+        return;
+    }
+
+    DamageRect regions[MAX_PUSH_REGIONS];
+    int count = mergeDamage(*view, m_sprite.width(), m_sprite.height(), regions, MAX_PUSH_REGIONS);
+    if (count < 0)
+    {
+        m_sprite.pushSprite(0, 0);
+        return;
+    }
+
+    m_lcd.startWrite();
+    for (int i = 0; i < count; i++)
+    {
+        pushRegion(regions[i]);
+    }
+    m_lcd.endWrite();
+}
+
+void DisplayManager::pushFrameDiff(View *view, bool forceFull)
+{
+    if (forceFull)
+    {
+        m_frameDiff.invalidate();
+    }
+
+    // Les hash de tuiles portent sur des pixels 16 bits : un sprite à palette est envoyé en entier
+    if (m_sprite.hasPalette())
+    {
+        m_frameDiff.invalidate();
+        m_sprite.pushSprite(0, 0);
+        return;
+    }
+
+    DamageRect runs[MAX_DIFF_RUNS];
+    int count = m_frameDiff.diff((const uint16_t *)m_sprite.getBuffer(), runs, MAX_DIFF_RUNS);
+
+    FrameDiff::Stats &stats = m_frameDiffStats[view];
+    stats.frames++;
+    stats.tilesPushed += m_frameDiff.lastTilesPushed();
+    stats.tilesSkipped += m_frameDiff.lastTilesSkipped();
+
+    if (count < 0)
+    {
+        m_sprite.pushSprite(0, 0);
+    }
+    else if (count > 0)
+    {
+        m_lcd.startWrite();
+        for (int i = 0; i < count; i++)
+        {
+            pushRegion(runs[i]);
+        }
+        m_lcd.endWrite();
+    }
+
+    unsigned long now = lgfx::v1::millis();
+    if (now - m_lastStatsLog > FRAME_DIFF_LOG_PERIOD)
+    {
+        m_lastStatsLog = now;
+        logFrameDiffStats();
+    }
+}
+
+void DisplayManager::logFrameDiffStats()
+{
+    for (const auto &entry : m_frameDiffStats)
+    {
+        const FrameDiff::Stats &stats = entry.second;
+        if (stats.frames == 0)
+            continue;
+        uint32_t total = stats.tilesPushed + stats.tilesSkipped;
+        ESP_LOGI("DisplayManager", "%s: %lu frames, %lu tuiles/frame envoyées, %lu ignorées (%lu%% économisé)",
+                 entry.first->getName(),
+                 (unsigned long)stats.frames,
+                 (unsigned long)(stats.tilesPushed / stats.frames),
+                 (unsigned long)(stats.tilesSkipped / stats.frames),
+                 (unsigned long)(total ? stats.tilesSkipped * 100 / total : 0));
+    }
+}
+
+void DisplayManager::pushRegion(const DamageRect &rect)
+{
+    // Le clip de l'écran limite pushSprite à la sous-fenêtre voulue
+    m_lcd.setClipRect(rect.x, rect.y, rect.w, rect.h);
+    m_sprite.pushSprite(0, 0);
+    m_lcd.clearClipRect();
+}
+void DisplayManager::setBacklight(uint8_t percent)
+{
+    // Clamp percent entre 0 et 100
+    if (percent > 100)
+        percent = 100;
+    // La méthode setBrightness attend une valeur entre 0 et 255
+    uint8_t value = (percent * 255) / 100;
+    m_lcd.setBrightness(value);
+}
+
+void DisplayManager::addView(std::unique_ptr<View> view)
+{
+    m_views.push_back(std::move(view));
+    if (m_currentView == nullptr)
+    {
+        m_currentView = m_views[0].get();
+        m_quality.selectView(m_currentView);
+        m_currentView->onEnterView();
+    }
+}
+
+void DisplayManager::setSettingsView(std::unique_ptr<View> view)
+{
+    m_settings_view = std::move(view);
+}
+
+void DisplayManager::nextView(int direction)
+{
+    if (m_views.empty())
+        return;
+
+    m_currentViewIdx = (m_currentViewIdx + direction + m_views.size()) % m_views.size();
+    switchView(m_views[m_currentViewIdx].get(), direction);
+}
+
+// Change de vue courante. La transition de la nouvelle vue est jouée si la frame de
+// l'ancienne est disponible (snapshot à jour ou sprite), sinon le changement est immédiat.
+void DisplayManager::switchView(View *view, int direction)
+{
+    m_transition.end();
+    m_transitionSnapshot = nullptr;
+
+    // Call onExitView on the current view if it exists
+    if (m_currentView != nullptr)
+    {
+        captureSnapshot();
+        if (m_bandFrames.isInitialized() && view->transitionStyle() != TransitionStyle::Cut)
+        {
+            const SnapshotCache::Snapshot *snapshot = nullptr;
+            if (m_currentView->usesSnapshotCache())
+                snapshot = m_snapshots.find(m_currentView);
+            if (snapshot != nullptr)
+                m_transition.useFrame(snapshot);
+            else if (m_spriteView == m_currentView)
+                m_transition.captureFrame(m_spriteRows, TRANSITION_FRAME_BUDGET);
+        }
+        m_currentView->onExitView();
+    }
+
+    m_currentView = view;
+    m_quality.selectView(view);
+    m_state.quality = m_quality.level();
+    m_currentView->setInitialRender(false);
+    m_forceFullPush = true;
+    m_spriteAllocFailed = false;
+    m_layersAllocFailed = false;
+    // Un pas de simulation dès la première frame de la vue
+    m_updateAccumUs = view->updateRate() > 0 ? 1000000 / view->updateRate() : 0;
+
+    // Call onEnterView on the new view
+    m_currentView->onEnterView();
+
+    m_transition.begin(view->transitionStyle(), direction, view->transitionDurationMs(), FrameClock::now());
+    if (m_transition.active() && view->usesSnapshotCache())
+    {
+        // Vue statique en cache : son snapshot remplace le rendu pendant la transition.
+        // Aucun snapshot n'est ajouté ni supprimé avant la fin de la transition (pointeurs stables).
+        const SnapshotCache::Snapshot *snapshot = m_snapshots.find(view);
+        if (snapshot != nullptr && snapshot->width == m_state.screenW && snapshot->height == m_state.screenH)
+            m_transitionSnapshot = snapshot;
+    }
+}
+
+// Cadence de la vue courante, relevée pendant une transition
+int DisplayManager::frameRate() const
+{
+    int fps = m_currentView->targetFps();
+    if (m_transition.active())
+        fps = std::max(fps, TRANSITION_FPS);
+    return fps;
+}
+
+// Échéance absolue (µs) du prochain travail : frame de la vue, lecture du touch maintenu
+// ou mise en veille. -1 si seule une interruption d'entrée peut produire du travail.
+int64_t DisplayManager::nextDeadline(int64_t now) const
+{
+    int64_t deadline = -1;
+    auto earliest = [&deadline](int64_t t)
+    {
+        if (deadline < 0 || t < deadline)
+            deadline = t;
+    };
+
+    // En veille, le rendu est figé : seules les entrées comptent
+    if (m_currentView != nullptr && !m_sleepMode)
+    {
+        int fps = frameRate();
+        if (!m_currentView->hasInitialRender() || (fps <= 0 && m_currentView->redrawRequested()))
+            earliest(now);
+        else if (fps > 0)
+            earliest(m_nextFrameUs);
+    }
+
+    if (!m_sleepMode)
+    {
+        int64_t awakeTimeUs = (int64_t)(Config::awakeTime * 60.0f * 1000000.0f);
+        earliest((int64_t)m_lastActivity * 1000 + awakeTimeUs);
+    }
+    return deadline;
+}
+
+// Bloque la tâche de rendu jusqu'au prochain travail ou à une interruption d'entrée
+void DisplayManager::waitForNextEvent()
+{
+    int64_t now = FrameClock::now();
+    int64_t deadline = m_input.hasEvents() ? now : nextDeadline(now);
+    if (deadline >= 0 && deadline <= now)
+    {
+        // Travail déjà dû : pas d'attente, mais la tâche idle de ce cœur doit
+        // tourner régulièrement (watchdog)
+        if (now - m_lastBlockUs >= IDLE_YIELD_PERIOD_US)
+        {
+            vTaskDelay(1);
+            m_lastBlockUs = FrameClock::now();
+        }
+        return;
+    }
+
+    if (deadline < 0 && m_sleepMode)
+    {
+        if (lightSleepAllowed(now))
+        {
+            // En veille et rien de prévu : seule une entrée peut réveiller le badge
+            lightSleepUntilInput();
+            m_lightSleepWakeUs = FrameClock::now();
+            m_lastBlockUs = m_lightSleepWakeUs;
+            return;
+        }
+        // Juste réveillé, ou appui en cours pas encore publié : la publication réveille la
+        // tâche de rendu, sinon le light sleep est réexaminé après le délai
+        int64_t graceEnd = m_lightSleepWakeUs + LIGHT_SLEEP_GRACE_US;
+        deadline = now < graceEnd ? graceEnd : now + LIGHT_SLEEP_GRACE_US;
+    }
+
+    m_frameClock.waitUntil(deadline);
+    m_lastBlockUs = FrameClock::now();
+}
+
+// Indique si la vue courante doit être rendue maintenant, et met à jour dt / t le cas échéant
+bool DisplayManager::frameDue(int64_t now)
+{
+    View *view = m_currentView;
+    int fps = frameRate();
+    bool first = !view->hasInitialRender();
+    bool requested = first || (fps <= 0 && view->redrawRequested());
+    if (!requested && (fps <= 0 || now < m_nextFrameUs))
+        return false;
+    m_redrawPending = view->redrawRequested();
+    view->clearRedrawRequest();
+
+    int64_t period = fps > 0 ? 1000000 / fps : 0;
+    if (fps > 0)
+    {
+        // Échéances absolues pour ne pas dériver ; après plus d'une période de retard
+        // (rendu trop long, changement de vue) on se recale sur l'instant présent
+        m_nextFrameUs += period;
+        if (m_nextFrameUs <= now)
+            m_nextFrameUs = now + period;
+    }
+
+    // Calculer le delta time
+    int64_t dt;
+    if (m_lastFrameUs == 0)
+    {
+        dt = period > 0 ? period : 1000000 / 30; // Valeur par défaut pour la première frame
+    }
+    else
+    {
+        dt = now - m_lastFrameUs;
+        if (fps > 0 && !first)
+            m_frameClock.recordFrame(dt, period);
+    }
+    m_frameElapsedUs = dt;
+    if (dt > MAX_FRAME_DT_US) // Limiter pour éviter les sauts
+        dt = MAX_FRAME_DT_US;
+
+    m_lastFrameUs = now;
+    m_state.t_us = now;
+    m_state.dt_us = dt;
+    m_state.t = now * 0.000001f;
+    m_state.dt = dt * 0.000001f;
+
+    if (now - m_lastClockLogUs > FRAME_CLOCK_LOG_PERIOD_US)
+    {
+        m_lastClockLogUs = now;
+        logFrameClockStats();
+        m_frameClock.resetStats();
+        m_latency.log();
+    }
+    return true;
+}
+
+void DisplayManager::logFrameClockStats()
+{
+    const FrameClock::Stats &stats = m_frameClock.stats();
+    if (stats.frames == 0 || m_currentView == nullptr)
+        return;
+    ESP_LOGI("DisplayManager", "%s @%d fps: %lu frames, gigue moy %lld us / max %lld us, retard réveil moy %lld us / max %lld us",
+             m_currentView->getName(), m_currentView->targetFps(),
+             (unsigned long)stats.frames,
+             (long long)(stats.jitterSumUs / stats.frames),
+             (long long)stats.jitterMaxUs,
+             (long long)(stats.wakeups ? stats.latencySumUs / stats.wakeups : 0),
+             (long long)stats.latencyMaxUs);
+}
+
+void DisplayManager::applyRotationFromConfig()
+{
+    ESP_LOGI("DisplayManager", "Applying rotation: %d", Config::display_rotated);
+    m_forceFullPush = true;
+    // Les vues statiques doivent aussi être redessinées dans la nouvelle orientation
+    if (m_currentView != nullptr)
+        m_currentView->requestRedraw();
+
+    uint8_t rotation = Config::display_rotated ? 2 : 0;
+    if (m_pushQueue)
+    {
+        // Le bus LCD appartient à la tâche d'envoi : la rotation y est appliquée entre deux frames
+        PushJob job = {};
+        job.type = PushJob::Rotation;
+        job.value = rotation;
+        xQueueSend(m_pushQueue, &job, portMAX_DELAY);
+        return;
+    }
+    setPanelRotation(rotation);
+}
+
+void DisplayManager::setPanelRotation(uint8_t rotation)
+{
+    m_lcd.waitDisplay(); // S'assurer que le LCD est prêt
+    m_lcd.setRotation(rotation);
 }
 
 void DisplayManager::handleButton()
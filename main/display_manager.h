@@ -2,13 +2,41 @@
 
 #include "lgfx_custom.h"
 #include "state.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
 
 #include <vector>
 #include <memory>
 
 #include "views/view.h"
 #include "views/view_settings.h"
+#include "frame_diff.h"
+#include "frame_rows.h"
+#include "row_post_processor.h"
+#include "layer_compositor.h"
+#include "snapshot_cache.h"
+#include "view_transition.h"
+#include "quality_controller.h"
+#include "frame_clock.h"
+#include "frame_watchdog.h"
+#include "input_latency.h"
+#include "bus_recorder.h"
+#include "input_manager.h"
+#include <lgfx/v1/misc/DividedFrameBuffer.hpp>
 #include <cstdint>
+#include <map>
+
+// 1 : rendu (entrées, simulation, dessin) et envoi SPI sur deux tâches épinglées
+// chacune sur un cœur ; 0 : une seule tâche display_loop comme auparavant
+#ifndef DISPLAY_DUAL_CORE
+#define DISPLAY_DUAL_CORE 1
+#endif
+
+// 1 : les vues qui le supportent sont rendues par moitiés en parallèle sur les deux cœurs
+#ifndef DISPLAY_SPLIT_RENDER
+#define DISPLAY_SPLIT_RENDER 1
+#endif
 
 class DisplayManager
 {
@@ -16,6 +44,8 @@ class DisplayManager
 public:
     DisplayManager(LGFX &lcd, AppState &state);
     void init();
+    // Crée la ou les tâches d'affichage (voir DISPLAY_DUAL_CORE)
+    void start();
     void displayLoop();
     void addView(std::unique_ptr<View> view);
     void setSettingsView(std::unique_ptr<View> view);
@@ -25,27 +55,215 @@ public:
     void updateAwakeTime(float minutes);
     // Applique la rotation selon Config::display_rotated
     void applyRotationFromConfig();
+    // Affiche les statistiques de tuiles envoyées/ignorées par vue
+    void logFrameDiffStats();
+    // Affiche la gigue des frames et le retard des réveils de la vue courante
+    void logFrameClockStats();
+    // Commandes console de l'affichage (dépassements d'échéance : "frames")
+    void registerConsoleCommands();
+    // Bus LCD instrumenté (profil SPI par frame et par vue, commande "bus") ; nullptr par défaut
+    void setBusRecorder(BusRecorder *recorder) { m_busRecorder = recorder; }
+    // Envoie tel quel le sprite plein écran où la vue courante est en train de dessiner, par la
+    // tâche d'envoi comme une frame, et retourne la durée de l'envoi DMA compris (µs). -1 si
+    // canvas n'est pas ce sprite 16 bits à pleine résolution (bandes de repli, palette, rendu
+    // réduit ou post-traité) : il n'y a alors aucun envoi de sprite à mesurer.
+    // À n'appeler que depuis render() (benchmark).
+    int64_t measureSpritePush(const LGFX_Sprite &canvas);
+
+    // Pilotage frame par frame sans les tâches d'affichage (benchmark et tests hôte, voir host/)
+    struct FrameTiming
+    {
+        int64_t updateUs;
+        int64_t renderUs; // render() / renderLayer() de la vue, hors update()
+        int64_t pushUs;   // Envoi à l'écran, mesuré seulement sans tâche d'envoi
+    };
+    size_t viewCount() const { return m_views.size(); }
+    View *viewAt(size_t index) const { return m_views[index].get(); }
+    void showView(size_t index);
+    bool stepFrame(int64_t nowUs);
+    FrameTiming lastFrameTiming() const;
 
 private:
+    // Travail transmis de la tâche de rendu à la tâche d'envoi
+    struct PushJob
+    {
+        enum Type : uint8_t
+        {
+            Frame,    // m_sprite est rendu, à envoyer puis à rendre via m_spriteFree
+            Band,     // la bande value de m_bandFrames (zone x, y, w, h) est rendue, rendue à m_freeBands après envoi
+            Rotation, // changement de rotation, appliqué dans l'ordre des frames
+            Sync,     // signale m_pushSync une fois les travaux précédents terminés
+            Measure,  // envoie m_sprite en cours de rendu, durée dans m_measuredPushUs, puis signale m_pushSync
+        };
+        Type type;
+        bool forceFull; // Frame : envoyer tout le sprite
+        bool first;     // Band : première bande de la frame
+        bool last;      // Band : dernière bande de la frame
+        uint8_t value;  // Band : index du buffer ; Rotation : rotation LCD
+        View *view;
+        int16_t x;
+        int16_t y;
+        int16_t w;
+        int16_t h;
+        int32_t budgetUs; // Frame, Band : budget d'envoi de la frame (FrameWatchdog)
+        int64_t inputUs;  // Frame, Band (last) : horodatage de l'entrée à laquelle la frame répond (0 : aucune)
+    };
+
     LGFX &m_lcd;
     AppState &m_state;
     std::vector<std::unique_ptr<View>> m_views;
     size_t m_currentViewIdx = 0;
     View *m_currentView = nullptr;
     std::unique_ptr<View> m_settings_view;
-    bool m_wasTouched = false;
-    unsigned long m_touchStartTime = 0;
-    bool m_longPressTriggered = false;
-    int m_touchX = -1;
-    int m_touchY = -1;
-    int m_touchEndX = -1;
-    int m_touchEndY = -1;
+    // Entrées tactiles (tâche dédiée) et état de l'appui en cours côté rendu
+    InputManager m_input;
+    // Appui déjà utilisé (réveil, appui long) : pas de clic au relâché
+    bool m_touchConsumed = false;
+    // Vue courante au Down : la suite de l'appui n'est pas transmise à une autre vue
+    View *m_touchView = nullptr;
     LGFX_Sprite m_sprite;
-    int m_targetFps = 30;
+    // Cadence des frames (µs, base FrameClock::now())
+    FrameClock m_frameClock;
+    int64_t m_lastFrameUs = 0;
+    int64_t m_nextFrameUs = 0;
+    // Temps réellement écoulé depuis la frame précédente (dt_us avant limitation)
+    int64_t m_frameElapsedUs = 0;
+    // Temps pas encore simulé par les pas fixes de la vue courante (View::updateRate())
+    int64_t m_updateAccumUs = 0;
+    int64_t m_lastBlockUs = 0;
+    int64_t m_lastClockLogUs = 0;
+    // Tâche de rendu, réveillée par l'horloge de frames et les interruptions du bouton et du touch
+    TaskHandle_t m_renderTask = nullptr;
     unsigned long m_lastActivity = 0;
     bool m_sleepMode = false;
+    // Contrôleur de l'écran en veille (SLPIN), uniquement si la luminosité de veille est nulle
+    bool m_panelAsleep = false;
+    // Rétroéclairage de veille sur le canal LEDC qui tourne en light sleep (luminosité de veille non nulle)
+    bool m_sleepBacklight = false;
+    // Fin du dernier light sleep : pas de nouveau light sleep avant LIGHT_SLEEP_GRACE_US
+    int64_t m_lightSleepWakeUs = 0;
+    // Force l'envoi de la frame complète au prochain rendu (changement de vue, rotation...)
+    bool m_forceFullPush = true;
+    // Différenciation par tuiles pour les vues qui ne signalent pas leurs zones
+    FrameDiff m_frameDiff;
+    std::map<const View *, FrameDiff::Stats> m_frameDiffStats;
+    // Dernières frames compressées des vues statiques, réaffichées sans render()
+    SnapshotCache m_snapshots;
+    // Vue dont la dernière frame complète est dans m_sprite (nullptr si aucune)
+    const View *m_spriteView = nullptr;
+    // Profondeur du sprite (16, 8 ou 4 bits), vue dont la palette y est chargée et lecture
+    // de ses lignes en RGB565 (palette reconstruite via m_paletteLut)
+    int m_spriteBits = 16;
+    // Facteur de réduction du sprite (2 : demi-résolution agrandie à l'envoi)
+    int m_spriteScale = 1;
+    const View *m_paletteView = nullptr;
+    FrameRows m_spriteRows;
+    uint16_t m_paletteLut[256];
+    // Transition en cours vers m_currentView ; snapshot affiché à la place de son rendu (vue statique)
+    ViewTransition m_transition;
+    const SnapshotCache::Snapshot *m_transitionSnapshot = nullptr;
+    // Niveau de qualité réglé d'après le temps de rendu (update + render) de chaque frame
+    QualityController m_quality;
+    int64_t m_frameRenderUs = 0;
+    int64_t m_frameUpdateUs = 0;
+    int64_t m_framePushUs = 0;
+    // Durées d'update, de rendu et d'envoi comparées au budget de la frame
+    FrameWatchdog m_watchdog;
+    // Latence tactile : horodatage de la plus ancienne entrée à laquelle la vue a réagi et pas
+    // encore affichée, puis celle de la frame en cours de rendu (0 : aucune)
+    InputLatency m_latency;
+    int64_t m_pendingInputUs = 0;
+    int64_t m_frameInputUs = 0;
+    BusRecorder *m_busRecorder = nullptr;
+    // Début de l'envoi de la frame en bandes en cours (côté envoi) : la durée mesurée
+    // jusqu'à la dernière bande comprend le rendu des bandes suivantes, en recouvrement
+    int64_t m_bandPushStartUs = 0;
+    // Couches de la vue composée par couches (View::layerCount()), à la place du sprite
+    LayerCompositor m_layers;
+    bool m_layersAllocFailed = false;
+    // Effets de lignes de la vue, appliqués dans les bandes DMA quand m_postActive
+    RowPostProcessor m_postProcessor;
+    bool m_postActive = false;
+    // La frame en cours a été demandée par requestRedraw() (vue statique)
+    bool m_redrawPending = false;
+    unsigned long m_lastStatsLog = 0;
+    // Rendu par bandes : deux blocs DMA utilisés en ping-pong. Le sprite plein écran
+    // n'est alloué que pour les vues FullFrame, les vues Banded n'utilisent que ces blocs.
+    LGFX_Sprite m_bandCanvas;
+    lgfx::DividedFrameBuffer m_bandFrames;
+    bool m_spriteAllocFailed = false;
+    int m_bandIndex = 0;
+    // Bande dont le DMA est en cours côté envoi (-1 si aucune)
+    int m_pendingBand = -1;
+    // Mode deux cœurs : files de travaux et de buffers libres, propriété du sprite
+    QueueHandle_t m_pushQueue = nullptr;
+    QueueHandle_t m_freeBands = nullptr;
+    SemaphoreHandle_t m_spriteFree = nullptr;
+    SemaphoreHandle_t m_pushSync = nullptr;
+    int64_t m_measuredPushUs = 0;
+    // Rendu en deux moitiés : la tâche auxiliaire dessine la moitié basse via m_splitCanvas
+    LGFX_Sprite m_splitCanvas;
+    TaskHandle_t m_splitTask = nullptr;
+    SemaphoreHandle_t m_splitDone = nullptr;
+    View *m_splitView = nullptr;
     void nextView(int direction = 1);
-    bool shouldRenderFrame();
+    void switchView(View *view, int direction);
+    void renderTransition();
+    bool renderFrame();
+    void produceFrame();
+    void runUpdates();
+    void updateQuality();
+    void checkFrameDeadlines();
+    void noteInputReaction(const TouchEvent &event);
+    int64_t takeFrameInput();
+    void framePushed(const View *view, int64_t inputUs);
+    int frameRate() const;
+    int64_t nextDeadline(int64_t now) const;
+    void waitForNextEvent();
+    bool frameDue(int64_t now);
+    static void inputIsr(void *arg);
+    bool consumeForceFullPush();
+    void pushFrame(View *view, bool forceFull);
+    void pushRegion(const DamageRect &rect);
+    void pushFrameDiff(View *view, bool forceFull);
+    void renderBanded();
+    void pushConverted();
+    int spriteScale(const View *view) const;
+    void submitBand(int y, int h, int buffer);
+    template <typename Fill>
+    void sendBands(Fill fill);
+    void submitRegion(const DamageRect &area, int buffer, bool first, bool last);
+    bool prepareLayers(View *view, bool &fresh);
+    bool renderLayers(View *view, bool &full);
+    bool renderLayered();
+    int addEffectRows(DamageRect *areas, int count, int maxRows);
+    void pushLayers(const DamageRect *areas, int count);
+    void captureSnapshot();
+    bool restoreSnapshot(View *view);
+    bool prepareFrameBuffer(bool banded);
+    uint16_t *bandBuffer(int index) const { return (uint16_t *)m_bandFrames.getBlockBuffer(index); }
+    void renderView(View *view, LGFX_Sprite &canvas, void *buffer, int y, int h);
+    static void spriteOverlay(void *arg, uint16_t *rows, int y, int h);
+    void splitLoop();
+    int acquireBand();
+    void releaseBand(int buffer);
+    void pushBand(const DamageRect &area, int buffer, bool first, bool last);
+    void setPanelRotation(uint8_t rotation);
+    void pushLoop();
+    static void renderTask(void *arg);
+    static void pushTask(void *arg);
+    static void splitTask(void *arg);
     void handleButton();
+    void processTouchEvent(const TouchEvent &event);
+    void handleClick(const TouchEvent &event, const TouchEvent &viewEvent);
+    void waitDisplay();
+    void waitPushIdle();
+    int64_t pushSpriteTimed();
+    void enterSleep();
+    void exitSleep();
+    void lightSleepUntilInput();
+    bool lightSleepAllowed(int64_t now) const;
+    void startSleepBacklight(uint8_t percent);
+    void stopSleepBacklight();
     void setBacklight(uint8_t percent);
 };
@@ -0,0 +1,79 @@
+#include "frame_clock.h"
+
+#include "esp_log.h"
+
+bool FrameClock::init()
+{
+    m_task = xTaskGetCurrentTaskHandle();
+
+    esp_timer_create_args_t args = {};
+    args.callback = onTimer;
+    args.arg = this;
+    args.dispatch_method = ESP_TIMER_TASK;
+    args.name = "frame_clock";
+    if (esp_timer_create(&args, &m_timer) != ESP_OK)
+    {
+        ESP_LOGW("FrameClock", "Timer creation failed, falling back to tick delays");
+        m_timer = nullptr;
+        return false;
+    }
+    return true;
+}
+
+void FrameClock::onTimer(void *arg)
+{
+    FrameClock *self = static_cast<FrameClock *>(arg);
+    xTaskNotifyGive(self->m_task);
+}
+
+bool FrameClock::waitUntil(int64_t deadlineUs)
+{
+    if (deadlineUs >= 0)
+    {
+        int64_t delay = deadlineUs - now();
+        if (delay <= 0)
+            return true;
+
+        if (m_timer == nullptr)
+        {
+            // Sans timer : attente au tick près (arrondie au-dessus)
+            int64_t tickUs = portTICK_PERIOD_MS * 1000;
+            ulTaskNotifyTake(pdTRUE, (TickType_t)((delay + tickUs - 1) / tickUs));
+        }
+        else
+        {
+            esp_timer_stop(m_timer);
+            esp_timer_start_once(m_timer, (uint64_t)delay);
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        }
+    }
+    else
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+
+    int64_t woken = now();
+    if (deadlineUs < 0 || woken < deadlineUs)
+    {
+        // Réveil par une entrée : l'échéance sera recalculée par l'appelant
+        if (m_timer)
+            esp_timer_stop(m_timer);
+        return false;
+    }
+
+    int64_t latency = woken - deadlineUs;
+    m_stats.wakeups++;
+    m_stats.latencySumUs += latency;
+    if (latency > m_stats.latencyMaxUs)
+        m_stats.latencyMaxUs = latency;
+    return true;
+}
+
+void FrameClock::recordFrame(int64_t intervalUs, int64_t periodUs)
+{
+    int64_t jitter = intervalUs > periodUs ? intervalUs - periodUs : periodUs - intervalUs;
+    m_stats.frames++;
+    m_stats.jitterSumUs += jitter;
+    if (jitter > m_stats.jitterMaxUs)
+        m_stats.jitterMaxUs = jitter;
+}
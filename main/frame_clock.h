@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+// Horloge de frames : réveille la tâche d'affichage par notification à une échéance
+// exprimée en microsecondes (timer esp_timer one-shot), sans la quantification du tick
+// FreeRTOS. Mesure aussi la gigue des frames et le retard des réveils.
+class FrameClock
+{
+public:
+    struct Stats
+    {
+        uint32_t frames = 0;       // Intervalles de frame mesurés
+        int64_t jitterSumUs = 0;   // Somme des |intervalle - période|
+        int64_t jitterMaxUs = 0;
+        uint32_t wakeups = 0;      // Réveils à l'échéance
+        int64_t latencySumUs = 0;  // Somme des retards de réveil après l'échéance
+        int64_t latencyMaxUs = 0;
+    };
+
+    // À appeler depuis la tâche qui attendra dans waitUntil()
+    bool init();
+
+    // Base de temps commune (µs depuis le démarrage)
+    static int64_t now() { return esp_timer_get_time(); }
+
+    // Bloque la tâche jusqu'à deadlineUs, ou plus tôt si une autre source (interruption
+    // d'entrée) notifie la tâche. deadlineUs < 0 : pas d'échéance.
+    // Retourne true si l'échéance est atteinte.
+    bool waitUntil(int64_t deadlineUs);
+
+    // Enregistre l'intervalle entre deux frames pour une période visée
+    void recordFrame(int64_t intervalUs, int64_t periodUs);
+
+    const Stats &stats() const { return m_stats; }
+    void resetStats() { m_stats = Stats(); }
+
+private:
+    static void onTimer(void *arg);
+
+    esp_timer_handle_t m_timer = nullptr;
+    TaskHandle_t m_task = nullptr;
+    Stats m_stats;
+};
@@ -0,0 +1,118 @@
+#include "frame_diff.h"
+
+void FrameDiff::init(int width, int height)
+{
+    m_width = width;
+    m_height = height;
+    m_cols = (width + TILE_SIZE - 1) / TILE_SIZE;
+    m_rows = (height + TILE_SIZE - 1) / TILE_SIZE;
+    m_hashes.assign(m_cols * m_rows, 0);
+    m_changed.assign(m_cols * m_rows, 0);
+    m_valid = false;
+}
+
+uint32_t FrameDiff::hashTile(const uint16_t *frame, int tx, int ty) const
+{
+    int x0 = tx * TILE_SIZE;
+    int y0 = ty * TILE_SIZE;
+    int w = (x0 + TILE_SIZE <= m_width) ? TILE_SIZE : m_width - x0;
+    int h = (y0 + TILE_SIZE <= m_height) ? TILE_SIZE : m_height - y0;
+
+    // FNV-1a sur des mots de 32 bits (2 pixels à la fois)
+    uint32_t hash = 2166136261u;
+    for (int y = 0; y < h; y++)
+    {
+        const uint16_t *line = frame + (y0 + y) * m_width + x0;
+        int x = 0;
+        if (((uintptr_t)line & 3) == 0)
+        {
+            const uint32_t *words = (const uint32_t *)line;
+            for (; x + 1 < w; x += 2)
+                hash = (hash ^ *words++) * 16777619u;
+        }
+        for (; x < w; x++)
+            hash = (hash ^ line[x]) * 16777619u;
+    }
+    return hash;
+}
+
+int FrameDiff::diff(const uint16_t *frame, DamageRect *runs, int maxRuns)
+{
+    int total = m_cols * m_rows;
+    int changed = 0;
+    for (int ty = 0; ty < m_rows; ty++)
+    {
+        for (int tx = 0; tx < m_cols; tx++)
+        {
+            int idx = ty * m_cols + tx;
+            uint32_t hash = hashTile(frame, tx, ty);
+            m_changed[idx] = !m_valid || hash != m_hashes[idx];
+            m_hashes[idx] = hash;
+            changed += m_changed[idx];
+        }
+    }
+
+    bool wasValid = m_valid;
+    m_valid = true;
+    m_lastPushed = changed;
+    m_lastSkipped = total - changed;
+
+    // Au-delà de 3/4 des tuiles, une transaction complète est plus rapide
+    if (!wasValid || changed * 4 > total * 3)
+    {
+        m_lastPushed = total;
+        m_lastSkipped = 0;
+        return -1;
+    }
+
+    // Regrouper les tuiles modifiées en bandes horizontales, puis fusionner
+    // verticalement les bandes identiques de deux rangées consécutives
+    int count = 0;
+    for (int ty = 0; ty < m_rows; ty++)
+    {
+        int tx = 0;
+        while (tx < m_cols)
+        {
+            if (!m_changed[ty * m_cols + tx])
+            {
+                tx++;
+                continue;
+            }
+            int start = tx;
+            while (tx < m_cols && m_changed[ty * m_cols + tx])
+                tx++;
+
+            DamageRect run = {start * TILE_SIZE, ty * TILE_SIZE, (tx - start) * TILE_SIZE, TILE_SIZE};
+            bool merged = false;
+            for (int i = 0; i < count; i++)
+            {
+                if (runs[i].x == run.x && runs[i].w == run.w && runs[i].y + runs[i].h == run.y)
+                {
+                    runs[i].h += TILE_SIZE;
+                    merged = true;
+                    break;
+                }
+            }
+            if (merged)
+                continue;
+            if (count >= maxRuns)
+            {
+                // Trop de zones : la frame part en entier, les statistiques doivent le refléter
+                m_lastPushed = total;
+                m_lastSkipped = 0;
+                return -1;
+            }
+            runs[count++] = run;
+        }
+    }
+
+    // Recadrer les tuiles du bord sur l'écran
+    for (int i = 0; i < count; i++)
+    {
+        if (runs[i].x + runs[i].w > m_width)
+            runs[i].w = m_width - runs[i].x;
+        if (runs[i].y + runs[i].h > m_height)
+            runs[i].h = m_height - runs[i].y;
+    }
+    return count;
+}
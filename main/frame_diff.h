@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "views/view.h"
+
+// Détection automatique des zones modifiées : le framebuffer est découpé en tuiles
+// dont on garde un hash pour la dernière frame envoyée. Seules les tuiles dont le
+// hash change sont renvoyées, regroupées en bandes horizontales.
+class FrameDiff
+{
+public:
+    static const int TILE_SIZE = 16;
+
+    struct Stats
+    {
+        uint32_t frames = 0;
+        uint32_t tilesPushed = 0;
+        uint32_t tilesSkipped = 0;
+    };
+
+    void init(int width, int height);
+    // Oublie les hash : la prochaine frame sera envoyée en entier
+    void invalidate() { m_valid = false; }
+
+    // Compare la frame aux hash précédents et remplit runs avec les zones à envoyer.
+    // Retourne le nombre de zones, ou -1 si la frame complète doit être envoyée.
+    int diff(const uint16_t *frame, DamageRect *runs, int maxRuns);
+
+    uint32_t lastTilesPushed() const { return m_lastPushed; }
+    uint32_t lastTilesSkipped() const { return m_lastSkipped; }
+
+private:
+    uint32_t hashTile(const uint16_t *frame, int tx, int ty) const;
+
+    int m_width = 0;
+    int m_height = 0;
+    int m_cols = 0;
+    int m_rows = 0;
+    bool m_valid = false;
+    std::vector<uint32_t> m_hashes;
+    std::vector<uint8_t> m_changed;
+    uint32_t m_lastPushed = 0;
+    uint32_t m_lastSkipped = 0;
+};
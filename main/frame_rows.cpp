@@ -0,0 +1,90 @@
+#include "frame_rows.h"
+
+#include <cstring>
+
+#include "layer_compositor.h"
+
+void FrameRows::attach(const void *buffer, int width, int height, int bpp, const uint16_t *lut, int scale)
+{
+    m_buffer = (const uint8_t *)buffer;
+    m_layers = nullptr;
+    m_width = width;
+    m_height = height;
+    m_bpp = bpp;
+    m_lut = lut;
+    m_scale = scale;
+}
+
+void FrameRows::attach(const LayerCompositor *layers, int width, int height)
+{
+    m_buffer = nullptr;
+    m_layers = layers;
+    m_width = width;
+    m_height = height;
+    m_bpp = 16;
+    m_scale = 1;
+}
+
+// Reconstruit une ligne du framebuffer (srcY en lignes du framebuffer) en pleine largeur
+void FrameRows::expandRow(int srcY, uint16_t *out) const
+{
+    const int srcWidth = m_width / m_scale;
+    const uint8_t *src = m_buffer + srcY * (srcWidth * m_bpp / 8);
+
+    if (m_scale == 1)
+    {
+        // Lignes indexées : 8 bits par pixel, ou 2 pixels par octet (pixel de gauche dans le quartet haut)
+        if (m_bpp == 8)
+        {
+            for (int x = 0; x < srcWidth; x++)
+                *out++ = m_lut[src[x]];
+        }
+        else
+        {
+            for (int x = 0; x < srcWidth; x += 2)
+            {
+                uint8_t pair = src[x >> 1];
+                *out++ = m_lut[pair >> 4];
+                *out++ = m_lut[pair & 0x0F];
+            }
+        }
+        return;
+    }
+
+    for (int x = 0; x < srcWidth; x++)
+    {
+        uint16_t c;
+        if (m_bpp == 16)
+            c = ((const uint16_t *)src)[x];
+        else if (m_bpp == 8)
+            c = m_lut[src[x]];
+        else
+            c = m_lut[(x & 1) ? (src[x >> 1] & 0x0F) : (src[x >> 1] >> 4)];
+        for (int i = 0; i < m_scale; i++)
+            *out++ = c;
+    }
+}
+
+const uint16_t *FrameRows::rows(int y, int rows, uint16_t *scratch) const
+{
+    if (m_layers)
+    {
+        m_layers->compose(0, y, m_width, rows, scratch);
+        return scratch;
+    }
+    if (m_bpp == 16 && m_scale == 1)
+        return (const uint16_t *)m_buffer + y * m_width;
+
+    for (int r = 0; r < rows; r++)
+    {
+        uint16_t *out = scratch + r * m_width;
+        // Une ligne agrandie identique à la précédente est simplement recopiée
+        if (r > 0 && (y + r) / m_scale == (y + r - 1) / m_scale)
+            memcpy(out, out - m_width, m_width * sizeof(uint16_t));
+        else
+            expandRow((y + r) / m_scale, out);
+    }
+    if (m_scale > 1 && m_overlay)
+        m_overlay(m_overlayArg, scratch, y, rows);
+    return scratch;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+class LayerCompositor;
+
+// Lecture ligne par ligne d'un framebuffer en RGB565 octets inversés (format du sprite 16 bits).
+// Un framebuffer indexé 4 ou 8 bits est reconstruit à la volée via une table de palette, et
+// un framebuffer en résolution réduite est agrandi (chaque pixel répété scale x scale fois),
+// puis complété par la surcouche éventuelle (setOverlay).
+// Les lignes d'une vue composée par couches sont recomposées à la demande.
+class FrameRows
+{
+public:
+    // Dessin ajouté aux lignes d'un framebuffer agrandi une fois reconstruites (surcouche pleine
+    // résolution de la vue) : rows contient les lignes [y, y + h) de l'écran
+    typedef void (*Overlay)(void *arg, uint16_t *rows, int y, int h);
+
+    void init(int width) { m_row.resize(width); }
+    void setOverlay(Overlay overlay, void *arg)
+    {
+        m_overlay = overlay;
+        m_overlayArg = arg;
+    }
+
+    // width, height : taille reconstruite (le framebuffer fait width / scale x height / scale).
+    // lut : couleurs RGB565 octets inversés de chaque index (nullptr pour un framebuffer 16 bits)
+    void attach(const void *buffer, int width, int height, int bpp, const uint16_t *lut, int scale = 1);
+    void attach(const LayerCompositor *layers, int width, int height);
+    void detach()
+    {
+        m_buffer = nullptr;
+        m_layers = nullptr;
+    }
+    bool attached() const { return m_buffer != nullptr || m_layers != nullptr; }
+
+    int width() const { return m_width; }
+    int height() const { return m_height; }
+
+    // rows lignes contiguës à partir de y : directement dans un framebuffer 16 bits pleine
+    // résolution, sinon reconstruites ou composées dans scratch (width * rows pixels)
+    const uint16_t *rows(int y, int rows, uint16_t *scratch) const;
+    // Une ligne, valide jusqu'à l'appel suivant
+    const uint16_t *row(int y) { return rows(y, 1, m_row.data()); }
+
+private:
+    void expandRow(int srcY, uint16_t *out) const;
+
+    const uint8_t *m_buffer = nullptr;
+    int m_width = 0;
+    int m_height = 0;
+    int m_bpp = 16;
+    int m_scale = 1;
+    const uint16_t *m_lut = nullptr;
+    const LayerCompositor *m_layers = nullptr;
+    Overlay m_overlay = nullptr;
+    void *m_overlayArg = nullptr;
+    std::vector<uint16_t> m_row;
+};
@@ -0,0 +1,179 @@
+#include "frame_watchdog.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "esp_console.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+// Budget d'une vue statique (rendue une fois, sans cadence) : seul un rendu anormalement
+// long est signalé
+#define STATIC_VIEW_BUDGET_US 200000
+#define MIN_BUDGET_PERCENT 10
+#define MAX_BUDGET_PERCENT 400
+// Derniers dépassements affichés par dump() (au plus RING_SIZE)
+#define DUMP_RECENT_COUNT 10
+
+FrameWatchdog *FrameWatchdog::s_instance = nullptr;
+
+const char *FrameWatchdog::stageName(Stage stage)
+{
+    switch (stage)
+    {
+    case Update:
+        return "update";
+    case Render:
+        return "render";
+    case Push:
+        return "push";
+    default:
+        return "?";
+    }
+}
+
+void FrameWatchdog::setBudgetPercent(int percent)
+{
+    m_budgetPercent = std::min(std::max(percent, MIN_BUDGET_PERCENT), MAX_BUDGET_PERCENT);
+}
+
+int32_t FrameWatchdog::budgetUs(int fps) const
+{
+    if (fps <= 0)
+        return STATIC_VIEW_BUDGET_US;
+    return (int32_t)((int64_t)1000000 * m_budgetPercent / (100 * fps));
+}
+
+void FrameWatchdog::check(const char *view, Stage stage, int64_t durationUs, int32_t budgetUs)
+{
+    if (durationUs <= budgetUs)
+        return;
+
+    int32_t duration = (int32_t)std::min<int64_t>(durationUs, INT32_MAX);
+    int64_t now = esp_timer_get_time();
+
+    portENTER_CRITICAL(&m_lock);
+    m_ring[m_next] = {view, stage, duration, budgetUs, now};
+    m_next = (m_next + 1) % RING_SIZE;
+    m_total++;
+
+    // Les noms de vue sont des constantes (getName()) : comparaison des pointeurs
+    Offender *offender = nullptr;
+    for (int i = 0; i < m_offenderCount; i++)
+    {
+        if (m_offenders[i].view == view && m_offenders[i].stage == stage)
+        {
+            offender = &m_offenders[i];
+            break;
+        }
+    }
+    if (offender == nullptr && m_offenderCount < MAX_OFFENDERS)
+    {
+        offender = &m_offenders[m_offenderCount++];
+        *offender = {view, stage, 0, 0, 0, 0};
+    }
+    if (offender != nullptr)
+    {
+        offender->count++;
+        offender->excessSumUs += duration - budgetUs;
+        if (duration > offender->worstUs)
+        {
+            offender->worstUs = duration;
+            offender->worstBudgetUs = budgetUs;
+        }
+    }
+    portEXIT_CRITICAL(&m_lock);
+
+    ESP_LOGD("FrameWatchdog", "%s %s: %ld us (budget %ld us)", view, stageName(stage), (long)duration, (long)budgetUs);
+}
+
+void FrameWatchdog::clear()
+{
+    portENTER_CRITICAL(&m_lock);
+    m_next = 0;
+    m_total = 0;
+    m_offenderCount = 0;
+    portEXIT_CRITICAL(&m_lock);
+}
+
+void FrameWatchdog::dump() const
+{
+    // Copie sous verrou, affichage ensuite (pas de printf en section critique)
+    static Overrun ring[RING_SIZE];
+    static Offender offenders[MAX_OFFENDERS];
+    portENTER_CRITICAL(&m_lock);
+    memcpy(ring, m_ring, sizeof(ring));
+    memcpy(offenders, m_offenders, sizeof(offenders));
+    int next = m_next;
+    uint32_t total = m_total;
+    int offenderCount = m_offenderCount;
+    portEXIT_CRITICAL(&m_lock);
+
+    printf("Frame overruns: %lu (budget %d%% of the view frame period)\n", (unsigned long)total, m_budgetPercent);
+    if (total == 0)
+        return;
+
+    std::sort(offenders, offenders + offenderCount,
+              [](const Offender &a, const Offender &b) { return a.worstUs > b.worstUs; });
+    printf("%-12s %-7s %8s %10s %10s %12s\n", "view", "stage", "count", "worst us", "budget us", "avg over us");
+    for (int i = 0; i < offenderCount; i++)
+    {
+        const Offender &o = offenders[i];
+        printf("%-12s %-7s %8lu %10ld %10ld %12lld\n", o.view, stageName(o.stage), (unsigned long)o.count,
+               (long)o.worstUs, (long)o.worstBudgetUs, (long long)(o.excessSumUs / o.count));
+    }
+
+    int recent = (int)std::min<uint32_t>(total, DUMP_RECENT_COUNT);
+    int64_t now = esp_timer_get_time();
+    printf("Last %d:\n", recent);
+    for (int i = 1; i <= recent; i++)
+    {
+        const Overrun &r = ring[(next - i + RING_SIZE) % RING_SIZE];
+        printf("  -%6lld ms  %-12s %-7s %8ld us (budget %ld us)\n", (long long)((now - r.timeUs) / 1000), r.view,
+               stageName(r.stage), (long)r.durationUs, (long)r.budgetUs);
+    }
+}
+
+int FrameWatchdog::command(int argc, char **argv)
+{
+    FrameWatchdog *self = s_instance;
+    if (self == nullptr)
+        return 1;
+
+    if (argc >= 2 && strcmp(argv[1], "clear") == 0)
+    {
+        self->clear();
+        printf("Frame overruns cleared\n");
+        return 0;
+    }
+    if (argc >= 2 && strcmp(argv[1], "budget") == 0)
+    {
+        if (argc >= 3)
+            self->setBudgetPercent(atoi(argv[2]));
+        printf("Frame budget: %d%% of the view frame period\n", self->budgetPercent());
+        return 0;
+    }
+    if (argc >= 2)
+    {
+        printf("Usage: frames [clear | budget [percent]]\n");
+        return 1;
+    }
+    self->dump();
+    return 0;
+}
+
+void FrameWatchdog::registerCommand()
+{
+    s_instance = this;
+
+    esp_console_cmd_t cmd = {};
+    cmd.command = "frames";
+    cmd.help = "Frame deadline overruns by view and stage (update, render, push). "
+               "'frames clear' resets them, 'frames budget <percent>' sets the budget.";
+    cmd.hint = "[clear | budget [percent]]";
+    cmd.func = &FrameWatchdog::command;
+    if (esp_console_cmd_register(&cmd) != ESP_OK)
+        ESP_LOGW("FrameWatchdog", "Console command registration failed");
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+
+#include "freertos/FreeRTOS.h"
+
+// Surveillance des échéances de frame : la durée de chaque étape (update, rendu, envoi) est
+// comparée à un budget tiré de la cadence de la vue. Les dépassements sont gardés dans un
+// tampon circulaire et cumulés par vue et par étape ; la commande console "frames" les affiche.
+// check() peut être appelée depuis la tâche de rendu comme depuis la tâche d'envoi.
+class FrameWatchdog
+{
+public:
+    enum Stage : uint8_t
+    {
+        Update, // update() de la vue (tous les pas de la frame)
+        Render, // render() / renderLayer() de la vue, toutes bandes comprises
+        Push,   // envoi de la frame à l'écran (sprite ou bandes)
+        STAGE_COUNT
+    };
+
+    struct Overrun
+    {
+        const char *view;
+        Stage stage;
+        int32_t durationUs;
+        int32_t budgetUs;
+        int64_t timeUs; // Instant du constat (base FrameClock::now())
+    };
+
+    // Dépassements cumulés d'une étape d'une vue
+    struct Offender
+    {
+        const char *view;
+        Stage stage;
+        uint32_t count;
+        int32_t worstUs;
+        int32_t worstBudgetUs;
+        int64_t excessSumUs; // Somme des durées au-delà du budget
+    };
+
+    static const int RING_SIZE = 32;
+    static const int MAX_OFFENDERS = 24; // 8 vues x 3 étapes
+
+    // Budget de chaque étape en pourcentage de la période de la vue (100 : une frame entière)
+    void setBudgetPercent(int percent);
+    int budgetPercent() const { return m_budgetPercent; }
+    // Budget (µs) d'une étape pour une vue rendue à fps images/s (fps 0 : vue statique)
+    int32_t budgetUs(int fps) const;
+
+    // Enregistre un dépassement si durationUs excède budgetUs
+    void check(const char *view, Stage stage, int64_t durationUs, int32_t budgetUs);
+    void clear();
+    // Pires étapes par vue puis derniers dépassements, sur la sortie standard (console)
+    void dump() const;
+
+    // Enregistre la commande console "frames" ; esp_console doit déjà être initialisé
+    // (esp_console_new_repl_*) et l'instance doit vivre aussi longtemps que la console.
+    void registerCommand();
+
+    static const char *stageName(Stage stage);
+
+private:
+    static int command(int argc, char **argv);
+    static FrameWatchdog *s_instance;
+
+    mutable portMUX_TYPE m_lock = portMUX_INITIALIZER_UNLOCKED;
+    int m_budgetPercent = 100;
+    Overrun m_ring[RING_SIZE];
+    int m_next = 0;
+    uint32_t m_total = 0;
+    Offender m_offenders[MAX_OFFENDERS];
+    int m_offenderCount = 0;
+};
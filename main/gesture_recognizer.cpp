@@ -0,0 +1,87 @@
+#include "gesture_recognizer.h"
+
+#include <cstdlib>
+
+// Durée d'appui déclenchant LongPress (et au-delà de laquelle un relâché n'est ni Tap ni Swipe)
+#define LONG_PRESS_US 1000000
+// Déplacement (pixels) depuis le Down à partir duquel l'appui devient un glissé
+#define DRAG_SLOP 10
+// Déplacement (pixels) minimal d'un Swipe
+#define SWIPE_MIN_DISTANCE 50
+// Poids du dernier échantillon dans la vitesse filtrée
+#define VELOCITY_SMOOTHING 0.5f
+
+TouchEvent GestureRecognizer::makeEvent(TouchEvent::Type type, int64_t timeUs, int32_t dtUs) const
+{
+    TouchEvent event = {};
+    event.type = type;
+    event.x = (int16_t)m_lastX;
+    event.y = (int16_t)m_lastY;
+    event.startX = (int16_t)m_startX;
+    event.startY = (int16_t)m_startY;
+    event.timeUs = timeUs;
+    event.dtUs = dtUs;
+    event.durationUs = (int32_t)(timeUs - m_startUs);
+    event.vx = m_vx;
+    event.vy = m_vy;
+    return event;
+}
+
+int GestureRecognizer::feed(bool touched, int x, int y, int64_t timeUs, TouchEvent *out)
+{
+    int count = 0;
+
+    if (touched && !m_down)
+    {
+        m_down = true;
+        m_dragging = false;
+        m_longPress = false;
+        m_startX = m_lastX = x;
+        m_startY = m_lastY = y;
+        m_startUs = m_lastUs = timeUs;
+        m_vx = m_vy = 0.0f;
+        out[count++] = makeEvent(TouchEvent::Down, timeUs, 0);
+        return count;
+    }
+
+    if (touched)
+    {
+        int32_t dt = (int32_t)(timeUs - m_lastUs);
+        if (dt > 0)
+        {
+            float vx = (x - m_lastX) * 1000000.0f / dt;
+            float vy = (y - m_lastY) * 1000000.0f / dt;
+            m_vx += (vx - m_vx) * VELOCITY_SMOOTHING;
+            m_vy += (vy - m_vy) * VELOCITY_SMOOTHING;
+        }
+        m_lastX = x;
+        m_lastY = y;
+        m_lastUs = timeUs;
+
+        if (!m_dragging && (std::abs(x - m_startX) > DRAG_SLOP || std::abs(y - m_startY) > DRAG_SLOP))
+            m_dragging = true;
+        out[count++] = makeEvent(m_dragging ? TouchEvent::Drag : TouchEvent::Hold, timeUs, dt);
+
+        if (!m_longPress && timeUs - m_startUs >= LONG_PRESS_US)
+        {
+            m_longPress = true;
+            out[count++] = makeEvent(TouchEvent::LongPress, timeUs, 0);
+        }
+        return count;
+    }
+
+    if (!m_down)
+        return 0;
+
+    // Relâché : la position et la vitesse sont celles du dernier échantillon posé
+    m_down = false;
+    if (!m_longPress && timeUs - m_startUs < LONG_PRESS_US)
+    {
+        int dx = m_lastX - m_startX;
+        int dy = m_lastY - m_startY;
+        bool swipe = dx * dx + dy * dy >= SWIPE_MIN_DISTANCE * SWIPE_MIN_DISTANCE;
+        out[count++] = makeEvent(swipe ? TouchEvent::Swipe : TouchEvent::Tap, timeUs, 0);
+    }
+    out[count++] = makeEvent(TouchEvent::Up, timeUs, (int32_t)(timeUs - m_lastUs));
+    return count;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+
+#include "touch_event.h"
+
+// Reconnaissance de gestes à partir des échantillons bruts du touch :
+// Down / Hold / Drag pendant l'appui, LongPress, puis Tap ou Swipe et Up au relâchement.
+class GestureRecognizer
+{
+public:
+    // Nombre maximal d'événements produits par un échantillon
+    static const int MAX_EVENTS = 3;
+
+    // Traite un échantillon (touched = doigt posé) et écrit les événements produits dans out.
+    // Retourne leur nombre.
+    int feed(bool touched, int x, int y, int64_t timeUs, TouchEvent *out);
+
+    bool isDown() const { return m_down; }
+
+private:
+    TouchEvent makeEvent(TouchEvent::Type type, int64_t timeUs, int32_t dtUs) const;
+
+    bool m_down = false;
+    bool m_dragging = false;
+    bool m_longPress = false;
+    int m_startX = 0;
+    int m_startY = 0;
+    int64_t m_startUs = 0;
+    int m_lastX = 0;
+    int m_lastY = 0;
+    int64_t m_lastUs = 0;
+    float m_vx = 0.0f;
+    float m_vy = 0.0f;
+};
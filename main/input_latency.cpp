@@ -0,0 +1,147 @@
+#include "input_latency.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include "esp_console.h"
+#include "esp_log.h"
+
+InputLatency *InputLatency::s_instance = nullptr;
+
+void InputLatency::record(const char *view, int64_t latencyUs)
+{
+    if (latencyUs < 0)
+        return;
+    int32_t latency = (int32_t)std::min<int64_t>(latencyUs, INT32_MAX);
+
+    portENTER_CRITICAL(&m_lock);
+    // Les noms de vue sont des constantes (getName()) : comparaison des pointeurs
+    ViewSamples *entry = nullptr;
+    for (int i = 0; i < m_viewCount; i++)
+    {
+        if (m_views[i].view == view)
+        {
+            entry = &m_views[i];
+            break;
+        }
+    }
+    if (entry == nullptr && m_viewCount < MAX_VIEWS)
+    {
+        entry = &m_views[m_viewCount++];
+        entry->view = view;
+        entry->count = 0;
+        entry->logged = 0;
+    }
+    if (entry != nullptr)
+    {
+        entry->samples[entry->count % SAMPLES] = latency;
+        entry->count++;
+    }
+    portEXIT_CRITICAL(&m_lock);
+}
+
+void InputLatency::clear()
+{
+    portENTER_CRITICAL(&m_lock);
+    m_viewCount = 0;
+    portEXIT_CRITICAL(&m_lock);
+}
+
+// Percentiles au rang le plus proche sur les mesures gardées
+InputLatency::Percentiles InputLatency::compute(const ViewSamples &entry)
+{
+    int32_t sorted[SAMPLES];
+    int n = (int)std::min<uint32_t>(entry.count, SAMPLES);
+    memcpy(sorted, entry.samples, n * sizeof(int32_t));
+    std::sort(sorted, sorted + n);
+
+    auto rank = [&](int percent) { return sorted[std::max(0, (n * percent + 99) / 100 - 1)]; };
+    Percentiles result = {};
+    result.count = entry.count;
+    if (n > 0)
+    {
+        result.p50Us = rank(50);
+        result.p95Us = rank(95);
+        result.p99Us = rank(99);
+        result.maxUs = sorted[n - 1];
+    }
+    return result;
+}
+
+void InputLatency::log()
+{
+    // Copie sous verrou, calcul et log ensuite
+    static ViewSamples entry;
+    for (int i = 0; i < MAX_VIEWS; i++)
+    {
+        portENTER_CRITICAL(&m_lock);
+        bool fresh = i < m_viewCount && m_views[i].count != m_views[i].logged;
+        if (fresh)
+        {
+            m_views[i].logged = m_views[i].count;
+            entry = m_views[i];
+        }
+        portEXIT_CRITICAL(&m_lock);
+        if (!fresh)
+            continue;
+
+        Percentiles p = compute(entry);
+        ESP_LOGI("InputLatency", "%s: %lu inputs, touch-to-photon p50 %ld us / p95 %ld us / p99 %ld us / max %ld us",
+                 entry.view, (unsigned long)p.count, (long)p.p50Us, (long)p.p95Us, (long)p.p99Us, (long)p.maxUs);
+    }
+}
+
+void InputLatency::dump() const
+{
+    static ViewSamples views[MAX_VIEWS];
+    portENTER_CRITICAL(&m_lock);
+    int count = m_viewCount;
+    memcpy(views, m_views, count * sizeof(ViewSamples));
+    portEXIT_CRITICAL(&m_lock);
+
+    printf("Touch-to-photon latency (last %d inputs per view)\n", SAMPLES);
+    if (count == 0)
+        return;
+    printf("%-12s %8s %10s %10s %10s %10s\n", "view", "inputs", "p50 us", "p95 us", "p99 us", "max us");
+    for (int i = 0; i < count; i++)
+    {
+        Percentiles p = compute(views[i]);
+        printf("%-12s %8lu %10ld %10ld %10ld %10ld\n", views[i].view, (unsigned long)p.count, (long)p.p50Us,
+               (long)p.p95Us, (long)p.p99Us, (long)p.maxUs);
+    }
+}
+
+int InputLatency::command(int argc, char **argv)
+{
+    InputLatency *self = s_instance;
+    if (self == nullptr)
+        return 1;
+
+    if (argc >= 2 && strcmp(argv[1], "clear") == 0)
+    {
+        self->clear();
+        printf("Touch latency cleared\n");
+        return 0;
+    }
+    if (argc >= 2)
+    {
+        printf("Usage: latency [clear]\n");
+        return 1;
+    }
+    self->dump();
+    return 0;
+}
+
+void InputLatency::registerCommand()
+{
+    s_instance = this;
+
+    esp_console_cmd_t cmd = {};
+    cmd.command = "latency";
+    cmd.help = "Touch-to-photon latency percentiles per view. 'latency clear' resets them.";
+    cmd.hint = "[clear]";
+    cmd.func = &InputLatency::command;
+    if (esp_console_cmd_register(&cmd) != ESP_OK)
+        ESP_LOGW("InputLatency", "Console command registration failed");
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+
+#include "freertos/FreeRTOS.h"
+
+// Latence tactile de bout en bout (touch-to-photon) : du relevé SPI de l'échantillon tactile
+// (TouchEvent::timeUs) à la fin de l'envoi de la première frame où la vue y a réagi.
+// Les SAMPLES dernières mesures de chaque vue donnent les percentiles p50 / p95 / p99.
+// record() est appelée depuis la tâche d'envoi, le reste depuis le rendu ou la console.
+class InputLatency
+{
+public:
+    static const int MAX_VIEWS = 8;
+    static const int SAMPLES = 64;
+
+    struct Percentiles
+    {
+        uint32_t count; // Mesures depuis le dernier clear() (percentiles sur les SAMPLES dernières)
+        int32_t p50Us;
+        int32_t p95Us;
+        int32_t p99Us;
+        int32_t maxUs;
+    };
+
+    void record(const char *view, int64_t latencyUs);
+    void clear();
+
+    // Percentiles des vues ayant reçu de nouvelles mesures depuis l'appel précédent (ESP_LOGI)
+    void log();
+    // Percentiles de toutes les vues mesurées, sur la sortie standard (console)
+    void dump() const;
+
+    // Enregistre la commande console "latency" ; esp_console doit déjà être initialisé
+    void registerCommand();
+
+private:
+    struct ViewSamples
+    {
+        const char *view;
+        uint32_t count;
+        uint32_t logged; // count au dernier log()
+        int32_t samples[SAMPLES];
+    };
+
+    static Percentiles compute(const ViewSamples &entry);
+    static int command(int argc, char **argv);
+    static InputLatency *s_instance;
+
+    mutable portMUX_TYPE m_lock = portMUX_INITIALIZER_UNLOCKED;
+    ViewSamples m_views[MAX_VIEWS];
+    int m_viewCount = 0;
+};
@@ -0,0 +1,152 @@
+#include "input_manager.h"
+
+#include "driver/gpio.h"
+#include "esp_attr.h"
+#include "esp_log.h"
+
+// Sortie T_IRQ du XPT2046 (pin_int dans lgfx_custom.h), à l'état bas quand l'écran est touché
+#define TOUCH_IRQ_GPIO GPIO_NUM_36
+// Période d'échantillonnage tant que le doigt est posé (120 Hz)
+#define TOUCH_SAMPLE_PERIOD_US 8333
+// Échantillons consécutifs sans contact avant de considérer le doigt levé
+#define TOUCH_RELEASE_SAMPLES 2
+// Cœur, pile et priorité de la tâche d'entrée (au-dessus des tâches d'affichage)
+#define INPUT_TASK_CORE 0
+#define INPUT_TASK_STACK 3072
+#define INPUT_TASK_PRIORITY 3
+
+bool InputManager::start()
+{
+    esp_timer_create_args_t args = {};
+    args.callback = onSampleTimer;
+    args.arg = this;
+    args.dispatch_method = ESP_TIMER_TASK;
+    args.name = "touch_sample";
+    if (esp_timer_create(&args, &m_sampleTimer) != ESP_OK)
+    {
+        ESP_LOGE("InputManager", "Sample timer creation failed");
+        return false;
+    }
+
+    if (xTaskCreatePinnedToCore(task, "input", INPUT_TASK_STACK, this, INPUT_TASK_PRIORITY, &m_task, INPUT_TASK_CORE) != pdPASS)
+    {
+        ESP_LOGE("InputManager", "Input task creation failed");
+        return false;
+    }
+
+    // Le service d'ISR peut déjà être installé (bouton BOOT)
+    gpio_install_isr_service(0);
+    gpio_set_intr_type(TOUCH_IRQ_GPIO, GPIO_INTR_NEGEDGE);
+    gpio_isr_handler_add(TOUCH_IRQ_GPIO, penIsr, this);
+    gpio_intr_enable(TOUCH_IRQ_GPIO);
+
+    // Un doigt déjà posé au démarrage ne produirait pas de front
+    xTaskNotifyGive(m_task);
+    return true;
+}
+
+void IRAM_ATTR InputManager::penIsr(void *arg)
+{
+    InputManager *self = static_cast<InputManager *>(arg);
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(self->m_task, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+void InputManager::onSampleTimer(void *arg)
+{
+    InputManager *self = static_cast<InputManager *>(arg);
+    xTaskNotifyGive(self->m_task);
+}
+
+void InputManager::task(void *arg)
+{
+    InputManager *self = static_cast<InputManager *>(arg);
+    while (true)
+    {
+        self->sampleLoop();
+    }
+}
+
+void InputManager::startSampling()
+{
+    // PENIRQ bascule pendant chaque conversion du XPT2046 : l'interruption est coupée
+    // et le timer prend le relais tant que le doigt est posé
+    gpio_intr_disable(TOUCH_IRQ_GPIO);
+    esp_timer_start_periodic(m_sampleTimer, TOUCH_SAMPLE_PERIOD_US);
+    m_sampling = true;
+}
+
+void InputManager::stopSampling()
+{
+    esp_timer_stop(m_sampleTimer);
+    m_sampling = false;
+    gpio_intr_enable(TOUCH_IRQ_GPIO);
+}
+
+void InputManager::sampleLoop()
+{
+    // Attente d'un appui (PENIRQ) ou de l'échantillon suivant (timer)
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    // Horodatage au début de la lecture SPI : point de départ de la latence tactile
+    int x = -1, y = -1;
+    int64_t now = esp_timer_get_time();
+    bool touched = m_lcd.getTouch(&x, &y);
+
+    if (touched)
+    {
+        m_releaseSamples = 0;
+        if (!m_sampling)
+            startSampling();
+    }
+    else if (m_sampling)
+    {
+        // Un échantillon manqué ne doit pas couper un glissé en deux appuis
+        if (++m_releaseSamples < TOUCH_RELEASE_SAMPLES)
+            return;
+        stopSampling();
+    }
+    else
+    {
+        // Front parasite sans contact
+        return;
+    }
+
+    TouchEvent events[GestureRecognizer::MAX_EVENTS];
+    int count = m_gestures.feed(touched, x, y, now, events);
+    if (count == 0)
+        return;
+
+    m_pressed.store(m_gestures.isDown(), std::memory_order_release);
+    for (int i = 0; i < count; i++)
+    {
+        if (!m_events.push(events[i]))
+        {
+            if ((m_dropped++ % 32) == 0)
+                ESP_LOGW("InputManager", "Event queue full, %lu events dropped", (unsigned long)m_dropped);
+        }
+    }
+    if (m_listener)
+        xTaskNotifyGive(m_listener);
+}
+
+bool InputManager::isPenDown() const
+{
+    return gpio_get_level(TOUCH_IRQ_GPIO) == 0;
+}
+
+void InputManager::enableSleepWakeup()
+{
+    gpio_intr_disable(TOUCH_IRQ_GPIO);
+    gpio_wakeup_enable(TOUCH_IRQ_GPIO, GPIO_INTR_LOW_LEVEL);
+}
+
+void InputManager::disableSleepWakeup()
+{
+    gpio_wakeup_disable(TOUCH_IRQ_GPIO);
+    gpio_set_intr_type(TOUCH_IRQ_GPIO, GPIO_INTR_NEGEDGE);
+    gpio_intr_enable(TOUCH_IRQ_GPIO);
+    // Le doigt qui a réveillé le SoC est peut-être déjà posé : pas de nouveau front à attendre
+    xTaskNotifyGive(m_task);
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "lgfx_custom.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "touch_event.h"
+#include "gesture_recognizer.h"
+#include "spsc_queue.h"
+
+// Tâche d'entrée tactile : réveillée par PENIRQ, elle échantillonne le XPT2046 à cadence
+// fixe tant que le doigt est posé, reconnaît les gestes et publie des TouchEvent dans une
+// file sans verrou lue par la tâche de rendu (une seule lecture SPI par échantillon).
+class InputManager
+{
+public:
+    explicit InputManager(LGFX &lcd) : m_lcd(lcd) {}
+
+    // Configure l'interruption PENIRQ et crée la tâche d'échantillonnage
+    bool start();
+    // Tâche notifiée après chaque publication d'événements
+    void setListener(TaskHandle_t task) { m_listener = task; }
+
+    // Côté consommateur : prochain événement en attente
+    bool poll(TouchEvent &event) { return m_events.pop(event); }
+    bool hasEvents() const { return !m_events.empty(); }
+    // Doigt posé (entre Down et Up)
+    bool isPressed() const { return m_pressed.load(std::memory_order_acquire); }
+    // Niveau de PENIRQ : bas tant que le doigt touche l'écran, même avant que la tâche
+    // d'entrée ait échantillonné l'appui
+    bool isPenDown() const;
+
+    // Light sleep : PENIRQ devient une source de réveil sur niveau bas, puis l'interruption
+    // sur front est rétablie au retour
+    void enableSleepWakeup();
+    void disableSleepWakeup();
+
+private:
+    static const int EVENT_QUEUE_SIZE = 32;
+
+    static void task(void *arg);
+    static void onSampleTimer(void *arg);
+    static void penIsr(void *arg);
+    void sampleLoop();
+    void startSampling();
+    void stopSampling();
+
+    LGFX &m_lcd;
+    TaskHandle_t m_task = nullptr;
+    TaskHandle_t m_listener = nullptr;
+    esp_timer_handle_t m_sampleTimer = nullptr;
+    bool m_sampling = false;
+    int m_releaseSamples = 0;
+    std::atomic<bool> m_pressed{false};
+    uint32_t m_dropped = 0;
+    GestureRecognizer m_gestures;
+    SpscQueue<TouchEvent, EVENT_QUEUE_SIZE> m_events;
+};
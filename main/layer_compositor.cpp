@@ -0,0 +1,125 @@
+#include "layer_compositor.h"
+
+#include <algorithm>
+
+#include "esp_log.h"
+
+// Index du pixel x d'une ligne en BITS bits par pixel (pixel de gauche dans les bits de poids fort)
+template <int BITS>
+static inline int pixelIndex(const uint8_t *row, int x)
+{
+    if (BITS == 8)
+        return row[x];
+    const int perByte = 8 / BITS;
+    const int shift = (perByte - 1 - (x % perByte)) * BITS;
+    return (row[x / perByte] >> shift) & ((1 << BITS) - 1);
+}
+
+// Superpose une ligne de couche sur out : tous les pixels pour la couche du fond (opaque),
+// sinon seulement ceux qui ne sont pas transparents
+template <int BITS>
+static void composeRow(const uint8_t *row, int x, int w, const uint16_t *lut, int transparent, uint16_t *out)
+{
+    if (transparent < 0)
+    {
+        for (int i = 0; i < w; i++)
+            out[i] = lut[pixelIndex<BITS>(row, x + i)];
+        return;
+    }
+
+    for (int i = 0; i < w; i++)
+    {
+        int index = pixelIndex<BITS>(row, x + i);
+        if (index != transparent)
+            out[i] = lut[index];
+    }
+}
+
+bool LayerCompositor::allocate(const View *view, int width, int height)
+{
+    release();
+    int count = std::min(view->layerCount(), MAX_LAYERS);
+    for (int i = 0; i < count; i++)
+    {
+        LayerInfo info = view->layerInfo(i);
+        Layer &layer = m_layers[i];
+        layer.bits = info.depth;
+        // La couche du fond est toujours opaque
+        layer.transparent = i == 0 ? -1 : info.transparent;
+        layer.sprite.setColorDepth(info.depth);
+        if (layer.sprite.createSprite(width, height) == nullptr || !layer.sprite.createPalette())
+        {
+            ESP_LOGW("LayerCompositor", "%s: layer %d (%d bpp) allocation failed", view->getName(), i, info.depth);
+            m_count = i + 1;
+            release();
+            return false;
+        }
+        // Largeur d'une ligne arrondie à l'octet, comme dans LGFX_Sprite
+        int xMask = 7 >> (info.depth >> 1);
+        layer.stride = (size_t)((width + xMask) & ~xMask) * info.depth / 8;
+    }
+    m_view = view;
+    m_count = count;
+    updatePalettes();
+    return true;
+}
+
+void LayerCompositor::release()
+{
+    for (int i = 0; i < m_count; i++)
+        m_layers[i].sprite.deleteSprite();
+    m_count = 0;
+    m_view = nullptr;
+}
+
+size_t LayerCompositor::bytes() const
+{
+    size_t total = 0;
+    for (int i = 0; i < m_count; i++)
+        total += m_layers[i].stride * m_layers[i].sprite.height();
+    return total;
+}
+
+void LayerCompositor::updatePalettes()
+{
+    for (int i = 0; i < m_count; i++)
+    {
+        LayerInfo info = m_view->layerInfo(i);
+        Layer &layer = m_layers[i];
+        int size = 1 << layer.bits;
+        int count = info.palette ? std::min(info.paletteCount, size) : 0;
+        for (int c = 0; c < size; c++)
+        {
+            uint16_t color = c < count ? info.palette[c] : 0;
+            layer.lut[c] = (uint16_t)((color >> 8) | (color << 8));
+        }
+    }
+}
+
+void LayerCompositor::compose(int x, int y, int w, int h, uint16_t *out) const
+{
+    for (int r = 0; r < h; r++)
+    {
+        uint16_t *dst = out + r * w;
+        for (int i = 0; i < m_count; i++)
+        {
+            const Layer &layer = m_layers[i];
+            const uint8_t *row = (const uint8_t *)layer.sprite.getBuffer() + (y + r) * layer.stride;
+            switch (layer.bits)
+            {
+            case 1:
+                composeRow<1>(row, x, w, layer.lut, layer.transparent, dst);
+                break;
+            case 2:
+                composeRow<2>(row, x, w, layer.lut, layer.transparent, dst);
+                break;
+            case 4:
+                composeRow<4>(row, x, w, layer.lut, layer.transparent, dst);
+                break;
+            default:
+                composeRow<8>(row, x, w, layer.lut, layer.transparent, dst);
+                break;
+            }
+        }
+    }
+}
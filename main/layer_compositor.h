@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "lgfx_custom.h"
+#include "views/view.h"
+
+// Couches d'une vue (View::layerCount()) : un sprite à palette plein écran par couche, gardé
+// d'une frame à l'autre. Les couches ne sont jamais envoyées telles quelles : compose()
+// reconstruit une zone en RGB565 octets inversés (format des bandes DMA) en superposant les
+// couches dans l'ordre, les pixels transparents laissant voir la couche inférieure.
+class LayerCompositor
+{
+public:
+    static const int MAX_LAYERS = 4;
+
+    ~LayerCompositor() { release(); }
+
+    // Crée les couches de view en width x height. Retourne false si la mémoire manque
+    // (rien n'est alors gardé).
+    bool allocate(const View *view, int width, int height);
+    void release();
+
+    // Vue dont les couches sont allouées (nullptr si aucune)
+    const View *view() const { return m_view; }
+    int count() const { return m_count; }
+    LGFX_Sprite &layer(int index) { return m_layers[index].sprite; }
+    size_t bytes() const;
+
+    // Relit les palettes de la vue (couleurs animées d'une frame à l'autre)
+    void updatePalettes();
+    // Compose les colonnes [x, x + w) des lignes [y, y + h) dans out (w pixels par ligne)
+    void compose(int x, int y, int w, int h, uint16_t *out) const;
+
+private:
+    struct Layer
+    {
+        LGFX_Sprite sprite;
+        int bits = 0;
+        int transparent = -1;
+        size_t stride = 0;
+        uint16_t lut[256];
+    };
+
+    const View *m_view = nullptr;
+    int m_count = 0;
+    Layer m_layers[MAX_LAYERS];
+};
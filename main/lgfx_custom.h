@@ -1,16 +1,35 @@
 #pragma once
 #include "LovyanGFX.hpp"
 
+#if defined(BADGE_HOST)
+
+// Build hôte (host/) : même géométrie sur un écran en mémoire
+#include "host_lgfx.h"
+
+#else
+
 // --- LGFX config custom for ESP32 CYD (2432S028) ---
 
 #include <lgfx/v1/touch/Touch_XPT2046.hpp>
 
+// Profil du bus SPI de l'écran (-DBADGE_BUS_PROFILE=1) : le panneau passe par un BusRecorder
+// qui relaie au Bus_SPI et compte octets, transactions et setWindow par frame (commande "bus")
+#ifndef BADGE_BUS_PROFILE
+#define BADGE_BUS_PROFILE 0
+#endif
+#if BADGE_BUS_PROFILE
+#include "bus_recorder.h"
+#endif
+
 class LGFX : public lgfx::LGFX_Device
 {
     lgfx::Panel_ILI9341 _panel_instance;
     lgfx::Bus_SPI _bus_instance;
     lgfx::Light_PWM _light_instance;
     lgfx::Touch_XPT2046 _touch_instance;
+#if BADGE_BUS_PROFILE
+    BusRecorder _bus_recorder;
+#endif
 
 public:
     LGFX(void)
@@ -30,7 +49,12 @@ public:
             cfg.pin_miso = 12;
             cfg.pin_dc = 2;
             _bus_instance.config(cfg);
+#if BADGE_BUS_PROFILE
+            _bus_recorder.setTarget(&_bus_instance);
+            _panel_instance.setBus(&_bus_recorder);
+#else
             _panel_instance.setBus(&_bus_instance);
+#endif
         }
         // Config écran
         {
@@ -79,11 +103,17 @@ public:
             cfg.x_max = 300;
             cfg.y_min = 500;
             cfg.y_max = 3800;
-            cfg.bus_shared = true;   // Bus partagé avec l'écran
+            cfg.bus_shared = false;  // Bus VSPI dédié : la lecture ne touche pas à la transaction de l'écran
             cfg.offset_rotation = 5; // Même rotation que l'écran
             _touch_instance.config(cfg);
             _panel_instance.setTouch(&_touch_instance);
         }
         setPanel(&_panel_instance);
     }
+
+#if BADGE_BUS_PROFILE
+    BusRecorder *busRecorder() { return &_bus_recorder; }
+#endif
 };
+
+#endif // BADGE_HOST
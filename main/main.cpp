@@ -11,6 +11,7 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "esp_log.h"
+#include "esp_console.h"
 #include "lgfx_custom.h"
 #include "display_manager.h"
 
@@ -24,6 +25,7 @@
 #include "views/view_program.h"
 #include "views/view_settings.h"
 #include "views/view_plasma.h"
+#include "views/view_benchmark.h"
 #include "user_info.h"
 
 // #include "battery_monitor.hpp"
@@ -31,6 +33,12 @@
 
 #define TAG "BADGE"
 
+// Vue de microbenchmark des primitives LovyanGFX (ViewBenchmark), en dernière position :
+// à activer (-DBADGE_BENCHMARK_VIEW=1) pour comparer builds et horloges sur la carte
+#ifndef BADGE_BENCHMARK_VIEW
+#define BADGE_BENCHMARK_VIEW 0
+#endif
+
 LGFX lcd;
 
 AppState appState;
@@ -45,14 +53,6 @@ DisplayManager displayManager(lcd, appState);
 //     1.40f          // V max NiMH
 // );
 
-void display_loop_task(void *pvParameter)
-{
-  while (true)
-  {
-    displayManager.displayLoop();
-  }
-}
-
 extern "C" void app_main(void)
 {
   Config::initNVS();
@@ -61,6 +61,9 @@ extern "C" void app_main(void)
   lcd.init();
   srand((unsigned int)time(NULL));
   displayManager.init();
+#if BADGE_BUS_PROFILE
+  displayManager.setBusRecorder(lcd.busRecorder());
+#endif
 
   // Ajout des vues
   displayManager.addView(std::make_unique<ViewBadge>(appState, lcd));
@@ -70,11 +73,30 @@ extern "C" void app_main(void)
   displayManager.addView(std::make_unique<ViewGame>(appState, lcd));
   displayManager.addView(std::make_unique<ViewCat>(appState, lcd));
 //  displayManager.addView(std::make_unique<ViewBattery>(&batteryMonitor));
+#if BADGE_BENCHMARK_VIEW
+  displayManager.addView(std::make_unique<ViewBenchmark>(lcd, displayManager));
+#endif
   displayManager.setSettingsView(std::make_unique<ViewSettings>(lcd, displayManager));
 
   // Génération du QR code de badge d'accès (après allocation des vues)
   user_info_generate_qrcode(user_info.accessBadgeToken.c_str());
 
-  // Lancement de la tâche d'affichage
-  xTaskCreate(display_loop_task, "display_loop", 4096, NULL, 2, NULL);
+  // Lancement des tâches d'affichage (rendu et envoi SPI)
+  displayManager.start();
+
+  // Console série de diagnostic ("frames" : dépassements d'échéance des vues, "bus" : profil SPI)
+  esp_console_repl_t *repl = nullptr;
+  esp_console_repl_config_t repl_config = ESP_CONSOLE_REPL_CONFIG_DEFAULT();
+  repl_config.prompt = "badge>";
+  esp_console_dev_uart_config_t uart_config = ESP_CONSOLE_DEV_UART_CONFIG_DEFAULT();
+  if (esp_console_new_repl_uart(&uart_config, &repl_config, &repl) == ESP_OK)
+  {
+    esp_console_register_help_command();
+    displayManager.registerConsoleCommands();
+    esp_console_start_repl(repl);
+  }
+  else
+  {
+    ESP_LOGW(TAG, "Console indisponible");
+  }
 }
\ No newline at end of file
@@ -0,0 +1,50 @@
+#include "quality_controller.h"
+
+// Lissage exponentiel du temps de rendu : poids 1/2^QUALITY_SMOOTHING_SHIFT par frame
+#define QUALITY_SMOOTHING_SHIFT 3
+// Frames à attendre après un changement avant de baisser à nouveau (la moyenne se recale)
+#define QUALITY_SETTLE_FRAMES 8
+// Frames avec de la marge avant de remonter d'un niveau
+#define QUALITY_RAISE_FRAMES 120
+// Moyenne (en % du budget) sous laquelle la qualité peut remonter
+#define QUALITY_RAISE_PERCENT 60
+
+void QualityController::selectView(const View *view)
+{
+    if (m_view != nullptr)
+        m_levels[m_view] = m_level;
+
+    m_view = view;
+    auto it = m_levels.find(view);
+    m_level = it != m_levels.end() ? it->second : LEVEL_MAX;
+    m_averageUs = 0;
+    m_framesSinceChange = 0;
+}
+
+bool QualityController::record(int64_t renderUs, int64_t budgetUs)
+{
+    if (m_framesSinceChange == 0 && m_averageUs == 0)
+        m_averageUs = renderUs;
+    else
+        m_averageUs += (renderUs - m_averageUs) >> QUALITY_SMOOTHING_SHIFT;
+    m_framesSinceChange++;
+
+    if (m_averageUs > budgetUs && m_level > 0 && m_framesSinceChange >= QUALITY_SETTLE_FRAMES)
+    {
+        setLevel(m_level - 1);
+        return true;
+    }
+    if (m_averageUs * 100 < budgetUs * QUALITY_RAISE_PERCENT && m_level < LEVEL_MAX &&
+        m_framesSinceChange >= QUALITY_RAISE_FRAMES)
+    {
+        setLevel(m_level + 1);
+        return true;
+    }
+    return false;
+}
+
+void QualityController::setLevel(int level)
+{
+    m_level = level;
+    m_framesSinceChange = 0;
+}
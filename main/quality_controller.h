@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+
+#include "views/view.h"
+
+// Règle un niveau de qualité d'après le temps de rendu des frames : le niveau baisse dès que
+// la moyenne dépasse le budget, et remonte après une longue période avec de la marge.
+// Les vues lisent le niveau (AppState::quality) pour alléger leurs effets.
+class QualityController
+{
+public:
+    static const int LEVEL_MAX = 3;
+
+    // Reprend le niveau atteint la dernière fois sur la vue (LEVEL_MAX la première fois)
+    void selectView(const View *view);
+    // Enregistre le temps de rendu d'une frame. Retourne true si le niveau a changé.
+    bool record(int64_t renderUs, int64_t budgetUs);
+
+    int level() const { return m_level; }
+    int64_t averageUs() const { return m_averageUs; }
+
+private:
+    void setLevel(int level);
+
+    const View *m_view = nullptr;
+    std::map<const View *, int> m_levels;
+    int m_level = LEVEL_MAX;
+    int64_t m_averageUs = 0;
+    // Frames enregistrées depuis le dernier changement de niveau
+    int m_framesSinceChange = 0;
+};
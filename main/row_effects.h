@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+
+// Effets plein écran appliqués aux lignes d'une frame pendant leur préparation pour le DMA
+// (voir RowPostProcessor), décrits par la vue à chaque frame. Un champ à 0 désactive l'effet.
+struct RowEffects
+{
+    // Scanlines : une ligne sur scanlineSpacing, à partir de scanlineOffset, assombrie de
+    // scanlineDarken quarts (1 à 4)
+    int scanlineSpacing = 0;
+    int scanlineOffset = 0;
+    int scanlineDarken = 2;
+
+    // Glitch : tranches de glitchSlice lignes décalées horizontalement d'au plus
+    // glitchAmplitude pixels, tirées d'après glitchSeed (un tirage par frame)
+    int glitchAmplitude = 0;
+    int glitchSlice = 6;
+    uint32_t glitchSeed = 0;
+
+    // Vignettage : assombrissement des bords, de 0 à 32 (coins noirs)
+    int vignette = 0;
+};
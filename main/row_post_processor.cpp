@@ -0,0 +1,217 @@
+#include "row_post_processor.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+// Masques RGB565 de deux pixels par mot : composantes divisées par 2 et par 4 sans déborder
+// sur la composante voisine
+#define RGB565_HALF_MASK 0x7BEF7BEFu
+#define RGB565_QUARTER_MASK 0x39E739E7u
+// RGB565 étalé sur 32 bits (voir ViewTransition) pour multiplier un pixel par un alpha sur 5 bits
+#define RGB565_SPREAD_MASK 0x07E0F81Fu
+
+// Inverse les octets de chaque pixel d'un mot : le format du sprite et l'ordre RGB565 se
+// convertissent l'un en l'autre par la même opération
+static inline uint32_t swapPair(uint32_t pair)
+{
+    return ((pair >> 8) & 0x00FF00FFu) | ((pair << 8) & 0xFF00FF00u);
+}
+
+// Assombrit deux pixels de quarters quarts (1 à 3), sans retenue entre composantes. La moitié
+// et le quart sont pris tous deux sur la couleur d'origine : 3 quarts en laissent bien 1/4.
+static inline uint32_t darkenPair(uint32_t pair, int quarters)
+{
+    uint32_t c = swapPair(pair);
+    uint32_t darken = 0;
+    if (quarters & 2)
+        darken += (c >> 1) & RGB565_HALF_MASK;
+    if (quarters & 1)
+        darken += (c >> 2) & RGB565_QUARTER_MASK;
+    return swapPair(c - darken);
+}
+
+// Profil du bord pour une position sur size pixels : nul sur la moitié centrale,
+// puis croissance quadratique jusqu'à 32
+static uint8_t edgeProfile(int pos, int size)
+{
+    int distance = std::abs(2 * pos + 1 - size);
+    int half = size / 2;
+    if (distance <= half)
+        return 0;
+    int t = (distance - half) * 32 / (size - half);
+    return (uint8_t)std::min(32, t * t / 32);
+}
+
+void RowPostProcessor::init(int width, int height)
+{
+    m_width = width;
+    m_height = height;
+    m_edgeX.resize(width);
+    m_edgeY.resize(height);
+    for (int x = 0; x < width; x++)
+        m_edgeX[x] = edgeProfile(x, width);
+    for (int y = 0; y < height; y++)
+        m_edgeY[y] = edgeProfile(y, height);
+
+    m_innerStart = 0;
+    while (m_innerStart < width && m_edgeX[m_innerStart] > 0)
+        m_innerStart++;
+    m_innerEnd = width;
+    while (m_innerEnd > m_innerStart && m_edgeX[m_innerEnd - 1] > 0)
+        m_innerEnd--;
+}
+
+bool RowPostProcessor::begin(const RowEffects &effects)
+{
+    m_previous = m_effects;
+    m_previousActive = m_active;
+    m_effects = effects;
+    m_effects.scanlineDarken = std::min(std::max(m_effects.scanlineDarken, 1), 4);
+    m_effects.glitchSlice = std::max(m_effects.glitchSlice, 1);
+    m_effects.glitchAmplitude = std::min(m_effects.glitchAmplitude, m_width / 4);
+    m_effects.vignette = std::min(m_effects.vignette, 32);
+    if (m_effects.scanlineSpacing > 0)
+        m_effects.scanlineOffset %= m_effects.scanlineSpacing;
+    m_active = m_width > 0 && (m_effects.scanlineSpacing > 0 || m_effects.glitchAmplitude > 0 || m_effects.vignette > 0);
+    return m_active;
+}
+
+void RowPostProcessor::apply(uint16_t *rows, int x, int y, int w, int h) const
+{
+    for (int i = 0; i < h; i++)
+    {
+        uint16_t *row = rows + i * w;
+        int screenY = y + i;
+
+        // Le glitch déplace le contenu ; scanlines et vignettage restent fixes à l'écran
+        if (m_effects.glitchAmplitude > 0 && w == m_width)
+        {
+            int shift = glitchShift(screenY);
+            if (shift != 0)
+                shiftRow(row, shift);
+        }
+        if (isScanline(m_effects, screenY))
+            darkenRow(row, w);
+        if (m_effects.vignette > 0)
+            vignetteRow(row, x, w, screenY);
+    }
+}
+
+bool RowPostProcessor::isScanline(const RowEffects &effects, int y) const
+{
+    return effects.scanlineSpacing > 0 && y % effects.scanlineSpacing == effects.scanlineOffset;
+}
+
+int RowPostProcessor::changedRows(DamageRect *rows, int maxRows) const
+{
+    if (!m_active || !m_previousActive || m_effects.glitchAmplitude > 0 || m_previous.glitchAmplitude > 0 ||
+        m_effects.vignette != m_previous.vignette || m_effects.scanlineSpacing != m_previous.scanlineSpacing ||
+        m_effects.scanlineDarken != m_previous.scanlineDarken)
+        return -1;
+    if (m_effects.scanlineOffset == m_previous.scanlineOffset)
+        return 0;
+
+    // Anciennes et nouvelles scanlines, les lignes voisines regroupées (défilement d'une ligne)
+    int count = 0;
+    int y = 0;
+    while (y < m_height)
+    {
+        if (!isScanline(m_effects, y) && !isScanline(m_previous, y))
+        {
+            y++;
+            continue;
+        }
+        int start = y;
+        while (y < m_height && (isScanline(m_effects, y) || isScanline(m_previous, y)))
+            y++;
+        if (count == maxRows)
+            return -1;
+        rows[count++] = {0, start, m_width, y - start};
+    }
+    return count;
+}
+
+// Décalage de la tranche contenant la ligne y : environ une tranche sur trois est décalée
+int RowPostProcessor::glitchShift(int y) const
+{
+    uint32_t hash = (uint32_t)(y / m_effects.glitchSlice + 1) * 2654435761u ^ m_effects.glitchSeed;
+    hash ^= hash >> 15;
+    hash *= 0x2C1B3C6Du;
+    hash ^= hash >> 12;
+    if (hash % 3 != 0)
+        return 0;
+    int amplitude = m_effects.glitchAmplitude;
+    return (int)((hash >> 8) % (uint32_t)(2 * amplitude + 1)) - amplitude;
+}
+
+// Décale la ligne de shift pixels (positif : vers la droite), le bord découvert prend la
+// couleur du pixel de bord
+void RowPostProcessor::shiftRow(uint16_t *row, int shift) const
+{
+    if (shift > 0)
+    {
+        memmove(row + shift, row, (m_width - shift) * sizeof(uint16_t));
+        std::fill(row, row + shift, row[shift]);
+    }
+    else
+    {
+        int count = -shift;
+        memmove(row, row + count, (m_width - count) * sizeof(uint16_t));
+        std::fill(row + m_width - count, row + m_width, row[m_width - count - 1]);
+    }
+}
+
+void RowPostProcessor::darkenRow(uint16_t *row, int w) const
+{
+    if (m_effects.scanlineDarken >= 4)
+    {
+        memset(row, 0, w * sizeof(uint16_t));
+        return;
+    }
+
+    const int quarters = m_effects.scanlineDarken;
+    int x = 0;
+    // Pixel isolé en tête si la ligne n'est pas alignée sur 32 bits
+    if (((uintptr_t)row & 2) != 0)
+    {
+        row[0] = (uint16_t)darkenPair(row[0], quarters);
+        x = 1;
+    }
+    uint32_t *pairs = (uint32_t *)(row + x);
+    int count = (w - x) / 2;
+    for (int i = 0; i < count; i++)
+        pairs[i] = darkenPair(pairs[i], quarters);
+    x += count * 2;
+    if (x < w)
+        row[x] = (uint16_t)darkenPair(row[x], quarters);
+}
+
+// Vignettage des colonnes [x0, x0 + w) de la ligne y de l'écran, rangées dans row
+void RowPostProcessor::vignetteRow(uint16_t *row, int x0, int w, int y) const
+{
+    const int edgeY = m_edgeY[y];
+    // Hors des bords haut et bas, seules les colonnes des bords gauche et droit sont touchées
+    const bool wholeRow = edgeY > 0;
+    const int x1 = x0 + w;
+
+    for (int x = x0; x < x1; x++)
+    {
+        if (!wholeRow && x >= m_innerStart && x < m_innerEnd)
+            x = m_innerEnd;
+        if (x >= x1)
+            break;
+
+        int dark = (m_effects.vignette * (m_edgeX[x] + edgeY)) >> 6;
+        uint32_t alpha = (uint32_t)(32 - std::min(dark, 32));
+        if (alpha >= 32)
+            continue;
+
+        uint16_t &pixel = row[x - x0];
+        uint16_t c = (uint16_t)((pixel >> 8) | (pixel << 8));
+        uint32_t spread = (c | ((uint32_t)c << 16)) & RGB565_SPREAD_MASK;
+        spread = ((spread * alpha) >> 5) & RGB565_SPREAD_MASK;
+        c = (uint16_t)(spread | (spread >> 16));
+        pixel = (uint16_t)((c >> 8) | (c << 8));
+    }
+}
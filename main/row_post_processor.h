@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "row_effects.h"
+#include "views/view.h"
+
+// Applique les effets plein écran (RowEffects) aux lignes RGB565 octets inversés déjà dans
+// les bandes DMA, juste avant leur envoi : quelques opérations sur deux pixels à la fois
+// par mot de 32 bits, au lieu de primitives dessinées sur toute la frame.
+class RowPostProcessor
+{
+public:
+    void init(int width, int height);
+
+    // Effets de la frame suivante (à appeler à chaque frame, RowEffects() sans effet). Retourne
+    // false si aucun n'est actif (apply() inutile).
+    bool begin(const RowEffects &effects);
+    // Applique les effets aux lignes [y, y + h) de l'écran, rangées dans rows (width pixels par ligne)
+    void apply(uint16_t *rows, int y, int h) const { apply(rows, 0, y, m_width, h); }
+    // Même chose pour la zone (x, y, w, h) de l'écran, rangée dans rows (w pixels par ligne).
+    // Sans glitch seulement si w < width : le décalage des lignes déborde de la zone.
+    void apply(uint16_t *rows, int x, int y, int w, int h) const;
+    // Lignes dont les effets diffèrent de la frame précédente, en bandes pleine largeur dans
+    // rows : seul le défilement des scanlines est suivi ainsi. Retourne -1 si toute la frame
+    // change (autre effet modifié, glitch, pas d'effets à la frame précédente) ou si plus de
+    // maxRows bandes seraient nécessaires.
+    int changedRows(DamageRect *rows, int maxRows) const;
+
+private:
+    int glitchShift(int y) const;
+    void shiftRow(uint16_t *row, int shift) const;
+    bool isScanline(const RowEffects &effects, int y) const;
+    void darkenRow(uint16_t *row, int w) const;
+    void vignetteRow(uint16_t *row, int x0, int w, int y) const;
+
+    int m_width = 0;
+    int m_height = 0;
+    RowEffects m_effects;
+    bool m_active = false;
+    // Effets de la frame précédente (ce qui est à l'écran hors zones renvoyées depuis)
+    RowEffects m_previous;
+    bool m_previousActive = false;
+    // Profil du vignettage (0 au centre, 32 au bord) par colonne et par ligne ; le profil
+    // horizontal est nul sur les colonnes [m_innerStart, m_innerEnd)
+    std::vector<uint8_t> m_edgeX;
+    std::vector<uint8_t> m_edgeY;
+    int m_innerStart = 0;
+    int m_innerEnd = 0;
+};
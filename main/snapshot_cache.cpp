@@ -0,0 +1,183 @@
+#include "snapshot_cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#include "esp_log.h"
+
+// Longueur minimale d'une répétition codée comme telle (sinon les pixels restent littéraux)
+#define RLE_MIN_RUN 3
+#define RLE_RUN_FLAG 0x8000
+#define RLE_MAX_COUNT 0x7FFF
+
+// Encode une ligne ; si out est nul, seule la taille (en mots) est calculée
+size_t SnapshotCache::encodeRow(const uint16_t *row, int width, uint16_t *out)
+{
+    size_t size = 0;
+    int x = 0;
+    while (x < width)
+    {
+        int run = 1;
+        while (x + run < width && run < RLE_MAX_COUNT && row[x + run] == row[x])
+            run++;
+
+        if (run >= RLE_MIN_RUN)
+        {
+            if (out)
+            {
+                out[size] = RLE_RUN_FLAG | run;
+                out[size + 1] = row[x];
+            }
+            size += 2;
+            x += run;
+            continue;
+        }
+
+        // Pixels littéraux jusqu'à la prochaine répétition
+        int start = x;
+        while (x < width && x - start < RLE_MAX_COUNT)
+        {
+            if (x + RLE_MIN_RUN <= width && row[x] == row[x + 1] && row[x] == row[x + 2])
+                break;
+            x++;
+        }
+        int count = x - start;
+        if (out)
+        {
+            out[size] = count;
+            memcpy(&out[size + 1], &row[start], count * sizeof(uint16_t));
+        }
+        size += 1 + count;
+    }
+    return size;
+}
+
+size_t SnapshotCache::encodedSize(FrameRows &frame)
+{
+    size_t words = 0;
+    for (int y = 0; y < frame.height(); y++)
+        words += encodeRow(frame.row(y), frame.width(), nullptr);
+    return words * sizeof(uint16_t);
+}
+
+bool SnapshotCache::encode(FrameRows &frame, Snapshot &snapshot)
+{
+    const int width = frame.width();
+    const int height = frame.height();
+    size_t words = encodedSize(frame) / sizeof(uint16_t);
+    // Sans exceptions (CONFIG_COMPILER_CXX_EXCEPTIONS), seul new (std::nothrow) signale le
+    // manque de mémoire. L'ancienne frame est libérée avant, pour ne pas garder les deux.
+    snapshot.data.reset();
+    snapshot.words = 0;
+    uint16_t *data = new (std::nothrow) uint16_t[words];
+    if (data == nullptr)
+        return false;
+
+    uint16_t *out = data;
+    for (int y = 0; y < height; y++)
+        out += encodeRow(frame.row(y), width, out);
+
+    snapshot.width = width;
+    snapshot.height = height;
+    snapshot.data.reset(data);
+    snapshot.words = words;
+    return true;
+}
+
+bool SnapshotCache::store(const View *view, FrameRows &frame)
+{
+    invalidate(view);
+    if (!frame.attached() || m_budget == 0)
+        return false;
+
+    size_t bytes = encodedSize(frame);
+    if (bytes > m_budget)
+    {
+        ESP_LOGI("SnapshotCache", "%s: snapshot too large (%u bytes)", view->getName(), (unsigned)bytes);
+        return false;
+    }
+
+    // Libérer les snapshots les plus anciens jusqu'à rentrer dans le budget
+    while (m_used + bytes > m_budget && !m_snapshots.empty())
+    {
+        size_t oldest = 0;
+        for (size_t i = 1; i < m_snapshots.size(); i++)
+        {
+            if (m_snapshots[i].lastUse < m_snapshots[oldest].lastUse)
+                oldest = i;
+        }
+        evict(oldest);
+    }
+
+    Snapshot snapshot;
+    snapshot.view = view;
+    snapshot.lastUse = ++m_useCounter;
+    if (!encode(frame, snapshot))
+        return false;
+
+    m_used += bytes;
+    m_snapshots.push_back(std::move(snapshot));
+    ESP_LOGI("SnapshotCache", "%s: snapshot stored (%u bytes, cache %u/%u)", view->getName(),
+             (unsigned)bytes, (unsigned)m_used, (unsigned)m_budget);
+    return true;
+}
+
+const SnapshotCache::Snapshot *SnapshotCache::find(const View *view)
+{
+    for (Snapshot &snapshot : m_snapshots)
+    {
+        if (snapshot.view == view)
+        {
+            snapshot.lastUse = ++m_useCounter;
+            return &snapshot;
+        }
+    }
+    return nullptr;
+}
+
+void SnapshotCache::invalidate(const View *view)
+{
+    for (size_t i = 0; i < m_snapshots.size(); i++)
+    {
+        if (m_snapshots[i].view == view)
+        {
+            evict(i);
+            return;
+        }
+    }
+}
+
+void SnapshotCache::clear()
+{
+    m_snapshots.clear();
+    m_used = 0;
+}
+
+void SnapshotCache::evict(size_t index)
+{
+    m_used -= m_snapshots[index].words * sizeof(uint16_t);
+    m_snapshots.erase(m_snapshots.begin() + index);
+}
+
+size_t SnapshotCache::decodeRows(const Snapshot &snapshot, size_t offset, uint16_t *out, int rows)
+{
+    const uint16_t *data = snapshot.data.get();
+    uint16_t *end = out + rows * snapshot.width;
+    while (out < end)
+    {
+        uint16_t header = data[offset++];
+        int count = header & RLE_MAX_COUNT;
+        if (header & RLE_RUN_FLAG)
+        {
+            std::fill(out, out + count, data[offset++]);
+        }
+        else
+        {
+            memcpy(out, &data[offset], count * sizeof(uint16_t));
+            offset += count;
+        }
+        out += count;
+    }
+    return offset;
+}
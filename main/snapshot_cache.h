@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "frame_rows.h"
+#include "views/view.h"
+
+// Après LovyanGFX : <memory> définit FILE sans déclarer fopen(), ce qui casse le DataWrapper
+// de la plateforme framebuffer (build hôte) s'il est inclus avant
+#include <memory>
+
+// Cache des dernières frames des vues statiques, compressées en RLE ligne par ligne.
+// Au retour sur une vue, la frame est décompressée directement dans les buffers d'envoi
+// SPI sans appeler render(). Le cache respecte un budget mémoire : les snapshots les
+// moins récemment utilisés sont supprimés en premier.
+class SnapshotCache
+{
+public:
+    struct Snapshot
+    {
+        const View *view = nullptr;
+        int width = 0;
+        int height = 0;
+        uint32_t lastUse = 0;
+        // Mots de 16 bits : en-tête (bit 15 = répétition, bits 0-14 = nombre de pixels)
+        // suivi d'un pixel répété ou des pixels littéraux. Aucune séquence ne déborde d'une ligne.
+        std::unique_ptr<uint16_t[]> data;
+        size_t words = 0;
+    };
+
+    void init(size_t budgetBytes) { m_budget = budgetBytes; }
+
+    // Compresse la frame (lignes RGB565 telles que stockées dans le sprite 16 bits) et remplace
+    // le snapshot de la vue. Retourne false si la frame compressée dépasse le budget ou si la mémoire manque.
+    bool store(const View *view, FrameRows &frame);
+    // Snapshot de la vue (marqué comme le plus récent), nullptr s'il n'existe pas
+    const Snapshot *find(const View *view);
+    void invalidate(const View *view);
+    void clear();
+
+    // Compresse une frame hors cache (taille en octets, puis encodage dans snapshot.data)
+    static size_t encodedSize(FrameRows &frame);
+    static bool encode(FrameRows &frame, Snapshot &snapshot);
+
+    // Décompresse rows lignes à partir de offset (position dans data) dans out.
+    // Retourne la position de la ligne suivante, à repasser à l'appel suivant.
+    static size_t decodeRows(const Snapshot &snapshot, size_t offset, uint16_t *out, int rows);
+
+    size_t usedBytes() const { return m_used; }
+
+private:
+    static size_t encodeRow(const uint16_t *row, int width, uint16_t *out);
+    void evict(size_t index);
+
+    std::vector<Snapshot> m_snapshots;
+    size_t m_budget = 0;
+    size_t m_used = 0;
+    uint32_t m_useCounter = 0;
+};
@@ -0,0 +1,248 @@
+#include "span_tracer.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "esp_console.h"
+#include "esp_cpu.h"
+#include "esp_ipc.h"
+#include "esp_log.h"
+#include "esp_rom_sys.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#if CONFIG_FREERTOS_UNICORE
+#define TRACE_CORE_COUNT 1
+#else
+#define TRACE_CORE_COUNT 2
+#endif
+// Temps laissé aux écritures en cours quand le dump suspend l'enregistrement
+#define DUMP_SETTLE_TICKS 2
+// Tâches distinctes nommées dans le JSON (pistes des processus "core N")
+#define MAX_DUMP_TASKS 12
+// Saturation du champ arg d'un événement
+#define MAX_EVENT_ARG 0xFFFFFF
+
+static const char *TAG = "SpanTracer";
+
+volatile bool SpanTracer::s_enabled = false;
+SpanTracer::Event *SpanTracer::s_ring = nullptr;
+std::atomic<uint32_t> SpanTracer::s_next{0};
+volatile bool SpanTracer::s_dmaActive = false;
+
+void SpanTracer::write(const char *name, Phase phase, uint32_t arg, bool dma)
+{
+    // Emplacement réservé atomiquement : les écrivains des deux cœurs ne se gênent pas
+    uint32_t index = s_next.fetch_add(1, std::memory_order_relaxed) & (RING_SIZE - 1);
+    Event &event = s_ring[index];
+    event.cycles = esp_cpu_get_cycle_count();
+    event.name = name;
+    event.task = dma ? nullptr : xTaskGetCurrentTaskHandle();
+    event.arg = std::min<uint32_t>(arg, MAX_EVENT_ARG);
+    event.phase = phase;
+    event.core = (uint8_t)esp_cpu_get_core_id();
+}
+
+void SpanTracer::dmaBegin(uint32_t bytes)
+{
+    if (!s_enabled)
+        return;
+    s_dmaActive = true;
+    write("dma", Begin, bytes, true);
+}
+
+void SpanTracer::dmaEnd()
+{
+    if (!s_dmaActive)
+        return;
+    s_dmaActive = false;
+    if (s_enabled)
+        write("dma", End, 0, true);
+}
+
+bool SpanTracer::start()
+{
+    if (s_ring == nullptr)
+    {
+        // Gardé jusqu'au redémarrage : un span en cours peut encore y écrire après stop()
+        s_ring = (Event *)calloc(RING_SIZE, sizeof(Event));
+        if (s_ring == nullptr)
+            return false;
+    }
+    s_enabled = true;
+    return true;
+}
+
+void SpanTracer::clear()
+{
+    bool wasEnabled = s_enabled;
+    s_enabled = false;
+    vTaskDelay(DUMP_SETTLE_TICKS);
+    s_next.store(0);
+    s_enabled = wasEnabled;
+}
+
+// Correspondance CCOUNT / esp_timer relevée sur chaque cœur : les compteurs de cycles des
+// deux cœurs ne sont pas synchronisés entre eux
+struct CoreAnchor
+{
+    uint32_t cycles;
+    int64_t timeUs;
+};
+
+static void sampleAnchor(void *arg)
+{
+    CoreAnchor *anchor = (CoreAnchor *)arg;
+    anchor->timeUs = esp_timer_get_time();
+    anchor->cycles = esp_cpu_get_cycle_count();
+}
+
+void SpanTracer::dump()
+{
+    if (s_ring == nullptr)
+    {
+        printf("{\"traceEvents\":[]}\n");
+        return;
+    }
+
+    bool wasEnabled = s_enabled;
+    s_enabled = false;
+    vTaskDelay(DUMP_SETTLE_TICKS);
+
+    CoreAnchor anchors[TRACE_CORE_COUNT];
+    for (int core = 0; core < TRACE_CORE_COUNT; core++)
+    {
+        if (core == esp_cpu_get_core_id())
+            sampleAnchor(&anchors[core]);
+        else
+            esp_ipc_call_blocking(core, sampleAnchor, &anchors[core]);
+    }
+    const uint32_t ticksPerUs = esp_rom_get_cpu_ticks_per_us();
+
+    // Plus ancien événement encore présent : le tampon a pu faire plusieurs tours
+    uint32_t total = s_next.load();
+    uint32_t count = std::min(total, RING_SIZE);
+    uint32_t first = total - count;
+
+    // Temps absolu (µs) d'un événement ; CCOUNT reboucle en 2^32 cycles (~18 s à 240 MHz),
+    // seuls les événements plus récents que cela sont placés correctement
+    auto eventTimeUs = [&](const Event &event) {
+        const CoreAnchor &anchor = anchors[std::min<int>(event.core, TRACE_CORE_COUNT - 1)];
+        uint32_t age = anchor.cycles - event.cycles;
+        return (double)anchor.timeUs - (double)age / ticksPerUs;
+    };
+    double originUs = 0;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        double t = eventTimeUs(s_ring[(first + i) & (RING_SIZE - 1)]);
+        if (i == 0 || t < originUs)
+            originUs = t;
+    }
+
+    // Une piste (tid) par tâche, la piste 0 de chaque cœur étant réservée au DMA
+    void *tasks[MAX_DUMP_TASKS];
+    uint8_t taskCores[MAX_DUMP_TASKS];
+    int taskCount = 0;
+    auto taskId = [&](const Event &event) {
+        if (event.task == nullptr)
+            return 0;
+        for (int i = 0; i < taskCount; i++)
+        {
+            if (tasks[i] == event.task && taskCores[i] == event.core)
+                return i + 1;
+        }
+        if (taskCount == MAX_DUMP_TASKS)
+            return MAX_DUMP_TASKS + 1;
+        tasks[taskCount] = event.task;
+        taskCores[taskCount] = event.core;
+        return ++taskCount;
+    };
+
+    printf("{\"traceEvents\":[\n");
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const Event &event = s_ring[(first + i) & (RING_SIZE - 1)];
+        printf("{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":%d,\"tid\":%d", event.name,
+               event.phase == Begin ? 'B' : 'E', eventTimeUs(event) - originUs, event.core, taskId(event));
+        if (event.phase == Begin && event.arg != 0)
+            printf(",\"args\":{\"bytes\":%u}", (unsigned)event.arg);
+        printf("},\n");
+    }
+    // Noms des processus (cœurs) et des pistes (tâches)
+    for (int core = 0; core < TRACE_CORE_COUNT; core++)
+    {
+        printf("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"name\":\"core %d\"}},\n", core, core);
+        printf("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":0,\"args\":{\"name\":\"SPI DMA\"}},\n", core);
+    }
+    for (int i = 0; i < taskCount; i++)
+    {
+        printf("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"%s\"}},\n",
+               taskCores[i], i + 1, pcTaskGetName((TaskHandle_t)tasks[i]));
+    }
+    printf("{\"name\":\"events\",\"ph\":\"M\",\"pid\":0,\"args\":{\"recorded\":%lu,\"kept\":%lu}}\n",
+           (unsigned long)total, (unsigned long)count);
+    printf("],\"displayTimeUnit\":\"ms\"}\n");
+    fflush(stdout);
+
+    s_enabled = wasEnabled;
+}
+
+int SpanTracer::command(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        dump();
+        return 0;
+    }
+    if (strcmp(argv[1], "start") == 0)
+    {
+        if (!start())
+        {
+            printf("Not enough memory for %lu trace events\n", (unsigned long)RING_SIZE);
+            return 1;
+        }
+        printf("Tracing started\n");
+        return 0;
+    }
+    if (strcmp(argv[1], "stop") == 0)
+    {
+        stop();
+        printf("Tracing stopped\n");
+        return 0;
+    }
+    if (strcmp(argv[1], "clear") == 0)
+    {
+        clear();
+        printf("Trace cleared\n");
+        return 0;
+    }
+    printf("Usage: trace [start|stop|clear]\n");
+    return 1;
+}
+
+void SpanTracer::registerCommand()
+{
+    esp_console_cmd_t cmd = {};
+    cmd.command = "trace";
+    cmd.help = "Span tracer. 'trace start' records, 'trace' dumps the last events as Chrome trace JSON.";
+    cmd.hint = "[start|stop|clear]";
+    cmd.func = &SpanTracer::command;
+    if (esp_console_cmd_register(&cmd) != ESP_OK)
+        ESP_LOGW(TAG, "Console command registration failed");
+}
+
+#if BADGE_TRACE
+// Crochets faibles déclarés par Bus_SPI (LovyanGFX)
+extern "C" void lgfx_trace_dma_begin(uint32_t length)
+{
+    SpanTracer::dmaBegin(length);
+}
+
+extern "C" void lgfx_trace_dma_end(void)
+{
+    SpanTracer::dmaEnd();
+}
+#endif
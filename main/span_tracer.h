@@ -0,0 +1,95 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Traces désactivables à la compilation : TRACE_SCOPE() ne coûte alors plus rien
+#ifndef BADGE_TRACE
+#define BADGE_TRACE 1
+#endif
+
+// Traceur d'intervalles (spans) : événements début / fin horodatés au compteur de cycles du
+// cœur (CCOUNT), écrits sans verrou dans un tampon circulaire de taille fixe par toutes les
+// tâches des deux cœurs. Les transferts DMA de Bus_SPI y sont ajoutés par les crochets
+// lgfx_trace_dma_begin() / lgfx_trace_dma_end(). La commande console "trace" démarre
+// l'enregistrement et vide le tampon au format JSON Chrome trace (chrome://tracing, Perfetto).
+// Le tampon n'est alloué qu'au premier "trace start" : sinon chaque span ne coûte qu'un test.
+class SpanTracer
+{
+public:
+    static const uint32_t RING_SIZE = 1024; // Puissance de 2
+
+    enum Phase : uint8_t
+    {
+        Begin,
+        End
+    };
+
+    // name doit être une constante (chaîne littérale) : seul le pointeur est gardé
+    static void begin(const char *name, uint32_t arg = 0) { record(name, Begin, arg); }
+    static void end(const char *name) { record(name, End, 0); }
+    static bool enabled() { return s_enabled; }
+
+    // Démarre l'enregistrement (alloue le tampon). Retourne false si la mémoire manque.
+    static bool start();
+    static void stop() { s_enabled = false; }
+    static void clear();
+    // Suspend l'enregistrement, écrit le tampon en JSON sur la sortie standard, puis reprend
+    static void dump();
+
+    // Enregistre la commande console "trace" ; esp_console doit déjà être initialisé
+    static void registerCommand();
+
+    // Span couvrant la portée courante
+    class Scope
+    {
+    public:
+        explicit Scope(const char *name, uint32_t arg = 0) : m_name(name) { begin(name, arg); }
+        ~Scope() { end(m_name); }
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+    private:
+        const char *m_name;
+    };
+
+    // Transferts DMA du bus SPI (crochets de Bus_SPI), sur une piste à part
+    static void dmaBegin(uint32_t bytes);
+    static void dmaEnd();
+
+private:
+    struct Event
+    {
+        uint32_t cycles; // CCOUNT du cœur qui a écrit l'événement
+        const char *name;
+        void *task;        // Tâche FreeRTOS, nullptr pour la piste DMA
+        uint32_t arg : 24; // Octets d'un transfert DMA (saturé)
+        uint32_t phase : 1;
+        uint32_t core : 7;
+    };
+
+    static void record(const char *name, Phase phase, uint32_t arg)
+    {
+        if (s_enabled)
+            write(name, phase, arg, false);
+    }
+    static void write(const char *name, Phase phase, uint32_t arg, bool dma);
+    static int command(int argc, char **argv);
+
+    static volatile bool s_enabled;
+    static Event *s_ring;
+    static std::atomic<uint32_t> s_next;
+    // DMA lancé et pas encore vu terminé : wait() / busy() n'enregistrent la fin qu'une fois
+    static volatile bool s_dmaActive;
+};
+
+#if BADGE_TRACE
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(name) SpanTracer::Scope TRACE_CONCAT(traceScope, __LINE__)(name)
+#else
+#define TRACE_SCOPE(name) \
+    do                    \
+    {                     \
+    } while (0)
+#endif
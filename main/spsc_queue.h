@@ -0,0 +1,47 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+// File circulaire sans verrou pour un producteur et un consommateur uniques
+// (tâches éventuellement sur des cœurs différents). N doit être une puissance de 2,
+// la capacité utile est de N - 1 éléments.
+template <typename T, size_t N>
+class SpscQueue
+{
+    static_assert((N & (N - 1)) == 0, "SpscQueue size must be a power of two");
+
+public:
+    // Côté producteur. Retourne false si la file est pleine.
+    bool push(const T &item)
+    {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        size_t next = (head + 1) & (N - 1);
+        if (next == m_tail.load(std::memory_order_acquire))
+            return false;
+        m_items[head] = item;
+        m_head.store(next, std::memory_order_release);
+        return true;
+    }
+
+    // Côté consommateur. Retourne false si la file est vide.
+    bool pop(T &item)
+    {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_head.load(std::memory_order_acquire))
+            return false;
+        item = m_items[tail];
+        m_tail.store((tail + 1) & (N - 1), std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const
+    {
+        return m_tail.load(std::memory_order_acquire) == m_head.load(std::memory_order_acquire);
+    }
+
+private:
+    T m_items[N];
+    std::atomic<size_t> m_head{0};
+    std::atomic<size_t> m_tail{0};
+};
@@ -20,6 +20,12 @@ class AppState
 public:
     float t = 0.0f;
     float dt = 0.016f; // Delta time (calculé globalement par DisplayManager)
+    // Mêmes valeurs en microsecondes (base esp_timer, sans perte de précision dans la durée)
+    int64_t t_us = 0;
+    int64_t dt_us = 16000;
+    // Niveau de qualité des effets (0 = minimal, QualityController::LEVEL_MAX = complet),
+    // abaissé par DisplayManager quand le rendu dépasse le budget de la frame
+    int quality = 3;
     int screenW = 0;
     int screenH = 0;
     int touch_x = -1;
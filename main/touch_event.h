@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+
+// Événement tactile horodaté, produit par la tâche d'entrée (InputManager)
+struct TouchEvent
+{
+    enum Type : uint8_t
+    {
+        Down,      // Doigt posé
+        Hold,      // Échantillon doigt posé, sans glissé au-delà du seuil
+        Drag,      // Échantillon doigt posé pendant un glissé (vitesse renseignée)
+        LongPress, // Doigt posé depuis plus d'une seconde (une fois par appui)
+        Tap,       // Relâché rapidement sans grand déplacement
+        Swipe,     // Relâché rapidement après un grand déplacement
+        Up,        // Doigt levé (toujours le dernier événement d'un appui)
+    };
+
+    Type type;
+    int16_t x, y;           // Position courante (pixels écran)
+    int16_t startX, startY; // Position au moment du Down
+    int64_t timeUs;         // Horodatage de l'échantillon (esp_timer_get_time)
+    int32_t dtUs;           // Temps depuis l'échantillon précédent du même appui
+    int32_t durationUs;     // Temps depuis le Down
+    float vx, vy;           // Vitesse filtrée (pixels/s)
+};
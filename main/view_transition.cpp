@@ -0,0 +1,120 @@
+#include "view_transition.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "esp_log.h"
+
+// Masque du RGB565 étalé sur 32 bits (vert en haut, rouge et bleu en bas) : chaque
+// composante garde 5 bits de marge pour la multiplication par un alpha sur 5 bits
+#define RGB565_SPREAD_MASK 0x07E0F81Fu
+
+bool ViewTransition::captureFrame(FrameRows &frame, size_t budgetBytes)
+{
+    m_outgoing = nullptr;
+    size_t bytes = SnapshotCache::encodedSize(frame);
+    if (bytes > budgetBytes)
+    {
+        ESP_LOGI("ViewTransition", "Outgoing frame too large (%u bytes), no transition", (unsigned)bytes);
+        return false;
+    }
+    if (!SnapshotCache::encode(frame, m_ownFrame))
+        return false;
+    m_outgoing = &m_ownFrame;
+    return true;
+}
+
+void ViewTransition::begin(TransitionStyle style, int direction, int durationMs, int64_t nowUs)
+{
+    // Sans direction, un glissement n'a pas de sens : fondu enchaîné
+    if (style == TransitionStyle::Slide && direction == 0)
+        style = TransitionStyle::Fade;
+
+    m_style = style;
+    m_direction = direction < 0 ? -1 : 1;
+    m_startUs = nowUs;
+    m_durationUs = (int64_t)durationMs * 1000;
+    m_progress = 0;
+    m_active = m_outgoing != nullptr && style != TransitionStyle::Cut && durationMs > 0 &&
+               (int)m_row.size() == m_outgoing->width;
+    if (!m_active)
+        end();
+}
+
+void ViewTransition::end()
+{
+    m_active = false;
+    m_outgoing = nullptr;
+    // Rendre la mémoire de la frame capturée
+    m_ownFrame.data.reset();
+    m_ownFrame.words = 0;
+}
+
+bool ViewTransition::advance(int64_t nowUs)
+{
+    int64_t elapsed = std::max<int64_t>(nowUs - m_startUs, 0);
+    if (elapsed >= m_durationUs)
+    {
+        m_progress = PROGRESS_MAX;
+        return true;
+    }
+
+    // Décélération quadratique : le mouvement ralentit en fin de transition
+    int linear = (int)(elapsed * PROGRESS_MAX / m_durationUs);
+    int remaining = PROGRESS_MAX - linear;
+    m_progress = PROGRESS_MAX - remaining * remaining / PROGRESS_MAX;
+    return false;
+}
+
+void ViewTransition::composeRows(const uint16_t *incoming, uint16_t *out, int h)
+{
+    const int width = (int)m_row.size();
+    for (int i = 0; i < h; i++)
+    {
+        // Les lignes de la frame quittée sont décodées dans l'ordre, une à la fois
+        m_offset = SnapshotCache::decodeRows(*m_outgoing, m_offset, m_row.data(), 1);
+        if (m_style == TransitionStyle::Slide)
+            composeSlide(incoming + i * width, out + i * width);
+        else
+            composeFade(incoming + i * width, out + i * width);
+    }
+}
+
+void ViewTransition::composeSlide(const uint16_t *incoming, uint16_t *out)
+{
+    const int width = (int)m_row.size();
+    int shift = m_progress * width / PROGRESS_MAX;
+    int kept = width - shift;
+
+    // Les pixels entrants sont déplacés d'abord (memmove : incoming peut être out),
+    // la partie restante de la vue quittée est ensuite copiée par-dessus leur ancienne place
+    if (m_direction > 0)
+    {
+        memmove(out + kept, incoming, shift * sizeof(uint16_t));
+        memcpy(out, m_row.data() + shift, kept * sizeof(uint16_t));
+    }
+    else
+    {
+        memmove(out, incoming + kept, shift * sizeof(uint16_t));
+        memcpy(out + shift, m_row.data(), kept * sizeof(uint16_t));
+    }
+}
+
+void ViewTransition::composeFade(const uint16_t *incoming, uint16_t *out)
+{
+    const int width = (int)m_row.size();
+    const uint32_t alpha = (uint32_t)(m_progress * 32 / PROGRESS_MAX);
+    const uint16_t *outgoing = m_row.data();
+
+    for (int x = 0; x < width; x++)
+    {
+        // Pixels du sprite en RGB565 octets inversés : remis dans l'ordre avant le mélange
+        uint16_t a = (uint16_t)((outgoing[x] >> 8) | (outgoing[x] << 8));
+        uint16_t b = (uint16_t)((incoming[x] >> 8) | (incoming[x] << 8));
+        uint32_t sa = (a | ((uint32_t)a << 16)) & RGB565_SPREAD_MASK;
+        uint32_t sb = (b | ((uint32_t)b << 16)) & RGB565_SPREAD_MASK;
+        uint32_t mixed = ((sb * alpha + sa * (32 - alpha)) >> 5) & RGB565_SPREAD_MASK;
+        uint16_t c = (uint16_t)(mixed | (mixed >> 16));
+        out[x] = (uint16_t)((c >> 8) | (c << 8));
+    }
+}
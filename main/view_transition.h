@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "snapshot_cache.h"
+#include "views/view.h"
+
+// Transition entre deux vues composée ligne par ligne dans les bandes DMA : la frame de la
+// vue quittée est capturée une seule fois (compressée), la vue entrante est rendue
+// normalement puis les lignes sont décalées (Slide) ou mélangées en RGB565 (Fade).
+class ViewTransition
+{
+public:
+    // Échelle de la progression : 0 = vue quittée seule, PROGRESS_MAX = vue entrante seule
+    static const int PROGRESS_MAX = 256;
+
+    void init(int width) { m_row.resize(width); }
+
+    // Frame de la vue quittée : compressée ici (false si elle dépasse budgetBytes) ou
+    // empruntée au cache de snapshots (le pointeur doit rester valide pendant la transition)
+    bool captureFrame(FrameRows &frame, size_t budgetBytes);
+    void useFrame(const SnapshotCache::Snapshot *frame) { m_outgoing = frame; }
+    bool hasFrame() const { return m_outgoing != nullptr; }
+
+    // direction : +1 la vue entrante arrive par la droite, -1 par la gauche, 0 sans direction
+    void begin(TransitionStyle style, int direction, int durationMs, int64_t nowUs);
+    void end();
+    bool active() const { return m_active; }
+
+    // Calcule la progression de la frame à composer. Retourne true pour la dernière frame.
+    bool advance(int64_t nowUs);
+    // À appeler avant la première bande de chaque frame
+    void beginFrame() { m_offset = 0; }
+    // Compose h lignes : incoming contient les lignes de la vue entrante (peut être out)
+    void composeRows(const uint16_t *incoming, uint16_t *out, int h);
+
+private:
+    void composeSlide(const uint16_t *incoming, uint16_t *out);
+    void composeFade(const uint16_t *incoming, uint16_t *out);
+
+    bool m_active = false;
+    TransitionStyle m_style = TransitionStyle::Cut;
+    int m_direction = 0;
+    int64_t m_startUs = 0;
+    int64_t m_durationUs = 0;
+    int m_progress = 0;
+    SnapshotCache::Snapshot m_ownFrame;
+    const SnapshotCache::Snapshot *m_outgoing = nullptr;
+    // Position de décodage dans la frame quittée et ligne décodée courante
+    size_t m_offset = 0;
+    std::vector<uint16_t> m_row;
+};
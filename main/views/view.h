@@ -2,6 +2,38 @@
 #define VIEW_H
 
 #include "../lgfx_custom.h"
+#include "../touch_event.h"
+#include "../row_effects.h"
+
+// Zone rectangulaire modifiée pendant un rendu (coordonnées du sprite)
+struct DamageRect
+{
+    int x, y, w, h;
+};
+
+// Façon dont DisplayManager produit les frames d'une vue
+enum class RenderMode
+{
+    FullFrame, // Rendu dans le sprite plein écran, puis envoi
+    Banded     // Rendu bande par bande pendant l'envoi DMA de la bande précédente
+};
+
+// Animation jouée à l'entrée d'une vue (changement de vue ou ouverture des réglages)
+enum class TransitionStyle
+{
+    Cut,   // Affichage immédiat
+    Slide, // La nouvelle vue pousse l'ancienne latéralement
+    Fade   // Fondu enchaîné entre les deux vues
+};
+
+// Couche d'une vue composée par DisplayManager (voir View::layerCount())
+struct LayerInfo
+{
+    int depth;               // 1, 2, 4 ou 8 bits par pixel : index dans palette
+    const uint16_t *palette; // Couleurs RGB565, relues à chaque frame (peuvent être animées)
+    int paletteCount;
+    int transparent;         // Index laissant voir les couches inférieures (-1 : couche opaque)
+};
 
 class View
 {
@@ -10,8 +42,36 @@ public:
     virtual ~View() = default;
     virtual void render(LGFX &display, LGFX_Sprite &spr) = 0;
 
+    // Mise à jour de l'état (animations, simulation), appelée avant render() : une fois par
+    // frame, ou une fois par pas fixe (voir updateRate()).
+    // En mode Banded, render() est appelée une fois par bande (clip sur la bande) et ne doit que dessiner.
+    virtual void update(float dt) {}
+    // Cadence fixe de la simulation en pas/s (0 : un update(dt) par frame avec le dt mesuré).
+    // Sinon DisplayManager appelle update(1 / updateRate()) autant de fois que le temps écoulé
+    // l'exige, quelle que soit la cadence de rendu : la simulation ne dépend plus des FPS.
+    // render() dessine alors entre les deux derniers états d'après interpolation().
+    virtual int updateRate() const { return 0; }
+    // Fraction du pas fixe écoulée depuis le dernier update() (0 à 1), réglée avant render()
+    float interpolation() const { return m_interpolation; }
+    void setInterpolation(float alpha) { m_interpolation = alpha; }
+    virtual RenderMode renderMode() const { return RenderMode::FullFrame; }
+    // Indique si render() peut être appelée en parallèle sur les deux cœurs, chaque appel avec
+    // son propre clip (moitié haute / moitié basse) : render() ne doit alors que lire l'état
+    // de la vue et ne pas modifier le clip du sprite.
+    virtual bool supportsSplitRender() const { return false; }
+
+    // Nom court de la vue (logs et statistiques)
+    virtual const char *getName() const { return "View"; }
+
     // Indique si la vue doit être rendue à chaque frame (dynamique) ou une seule fois (statique)
     virtual bool needsRedraw() const { return m_needsRedraw; }
+    // Cadence de rendu souhaitée en images/s (0, 5, 15, 30 ou 60). 0 : vue statique, rendue
+    // à l'entrée puis seulement sur requestRedraw() ; la tâche d'affichage reste alors bloquée.
+    virtual int targetFps() const { return needsRedraw() ? 30 : 0; }
+    // Demande un rendu unique, quelle que soit la cadence de la vue
+    void requestRedraw() { m_redrawRequested = true; }
+    bool redrawRequested() const { return m_redrawRequested; }
+    void clearRedrawRequest() { m_redrawRequested = false; }
     // Permet de forcer le redraw d'une vue statique si besoin
     virtual void forceRedraw()
     {
@@ -29,6 +89,25 @@ public:
     // Méthode virtuelle pour gérer les touches (optionnelle)
     // Retourne true si la vue a consommé le touch (ne pas changer de vue)
     virtual bool handleTouch(int x, int y) { return false; }
+
+    // Événement tactile horodaté (échantillons à cadence fixe, gestes reconnus).
+    // Par défaut, les échantillons du doigt posé sont transmis à handleTouch(x, y) et le
+    // relâché à handleTouch(-1, -1). Le clic (Tap) reste traité par DisplayManager.
+    // Retourne true si la vue a consommé l'événement.
+    virtual bool handleTouchEvent(const TouchEvent &event)
+    {
+        switch (event.type)
+        {
+        case TouchEvent::Hold:
+        case TouchEvent::Drag:
+            return handleTouch(event.x, event.y);
+        case TouchEvent::Up:
+            handleTouch(-1, -1);
+            return false;
+        default:
+            return false;
+        }
+    }
     
     // Indique si la vue est interactive et nécessite de désactiver l'appui long
     virtual bool isInteractiveView() const { return false; }
@@ -39,11 +118,101 @@ public:
 
     virtual void onEnterView() {}
     virtual void onExitView() {}
+
+    // Indique si la vue signale elle-même les zones modifiées via addDamage() pendant render().
+    // Dans ce cas DisplayManager ne pousse que ces zones, sinon la frame complète est envoyée.
+    virtual bool reportsDamage() const { return false; }
+
+    // Indique si la dernière frame de la vue peut être gardée compressée en mémoire pour
+    // être réaffichée sans render() quand on revient sur la vue (vues statiques par défaut).
+    virtual bool usesSnapshotCache() const { return targetFps() == 0; }
+
+    // Profondeur de couleur du sprite plein écran : 16 (RGB565), ou 8/4 bits indexés sur palette().
+    // Le sprite occupe alors 2 à 4 fois moins de RAM ; l'envoi reconstruit le RGB565 par blocs.
+    virtual int colorDepth() const { return 16; }
+    // Couleurs RGB565 de la palette (colorDepth() < 16), count reçoit le nombre d'entrées
+    virtual const uint16_t *palette(int &count) const
+    {
+        count = 0;
+        return nullptr;
+    }
+
+    // Facteur de réduction du rendu : 2 pour dessiner dans un sprite de demi-résolution
+    // (spr.width() x spr.height()), agrandi 2x ligne par ligne pendant l'envoi DMA.
+    virtual int renderScale() const { return 1; }
+    // Surcouche pleine résolution d'une vue à renderScale() > 1 (texte fin...), dessinée sur les
+    // lignes une fois agrandies (envoi, transitions, snapshots). spr est en coordonnées écran, son
+    // clip limité aux lignes reconstruites : la vue peut ignorer celles qu'elle ne touche pas.
+    virtual void renderOverlay(LGFX_Sprite &spr) const {}
+
+    // Effets plein écran (scanlines, glitch, vignettage) de la frame, appliqués par DisplayManager
+    // aux lignes pendant l'envoi, après update(). Retourne false si la vue n'en utilise pas.
+    // Purement décoratifs : ils sont ignorés si les buffers de bandes n'ont pas pu être alloués.
+    virtual bool rowEffects(RowEffects &effects) const { return false; }
+
+    // Composition par couches : la vue dessine dans layerCount() sprites à palette conservés
+    // d'une frame à l'autre (couche 0 au fond). renderLayer() ne redessine que ce qui a changé
+    // et le signale via addDamage() ; DisplayManager ne recompose et n'envoie que ces zones.
+    // render() doit rester capable de tout dessiner dans un sprite 16 bits : il sert quand les
+    // couches n'ont pas pu être allouées.
+    virtual int layerCount() const { return 0; }
+    virtual LayerInfo layerInfo(int layer) const { return {8, nullptr, 0, -1}; }
+    // full : la couche vient d'être créée (contenu indéfini) et doit être entièrement redessinée
+    virtual void renderLayer(int layer, LGFX_Sprite &spr, bool full) {}
+
+    // Transition jouée quand la vue devient la vue courante, et sa durée (ms). Un Slide sans
+    // direction (retour des réglages) est joué en fondu.
+    virtual TransitionStyle transitionStyle() const { return TransitionStyle::Slide; }
+    virtual int transitionDurationMs() const { return 250; }
+
+    static const int MAX_DAMAGE_RECTS = 32;
+
+    int damageCount() const { return m_damageCount; }
+    const DamageRect &damageRect(int i) const { return m_damage[i]; }
+    bool hasFullDamage() const { return m_fullDamage; }
+    void clearDamage()
+    {
+        m_damageCount = 0;
+        m_fullDamage = false;
+    }
     
     bool m_needsRedraw;
 
 protected:
     bool m_hasInitialRender;
+
+    // Ajoute une zone modifiée pour la frame en cours
+    void addDamage(int x, int y, int w, int h)
+    {
+        if (w <= 0 || h <= 0)
+            return;
+        if (m_damageCount >= MAX_DAMAGE_RECTS)
+        {
+            // Trop de zones : on repasse en frame complète
+            m_fullDamage = true;
+            return;
+        }
+        m_damage[m_damageCount++] = {x, y, w, h};
+    }
+    void addFullDamage() { m_fullDamage = true; }
+
+    // Couleur à passer aux primitives pour l'entrée index de palette() : l'index lui-même dans
+    // un sprite à palette, la couleur RGB565 dans un canvas 16 bits (rendu par bandes de secours)
+    uint16_t paletteColor(LGFX_Sprite &spr, int index) const
+    {
+        if (spr.hasPalette())
+            return (uint16_t)index;
+        int count = 0;
+        const uint16_t *colors = palette(count);
+        return index < count ? colors[index] : 0;
+    }
+
+private:
+    DamageRect m_damage[MAX_DAMAGE_RECTS];
+    int m_damageCount = 0;
+    volatile bool m_redrawRequested = false;
+    float m_interpolation = 1.0f;
+    bool m_fullDamage = false;
 };
 
 #endif // VIEW_H
@@ -1,13 +1,16 @@
 
 #include "view_badge.h"
+#include "../span_tracer.h"
 #include "user_info.h"
 #include <string>
 #include <vector>
 #include "state.h"
 #include <cmath>
+#include <algorithm>
 #include "esp_timer.h"
 #include "esp_random.h"
 #include "esp_log.h"
+#include "../quality_controller.h"
 #include "../Orbitron_Bold24pt7b.h"
 #include "retro_colors.h"
 #include "config.h"
@@ -17,6 +20,14 @@ ViewBadge::ViewBadge(AppState &state, LGFX &lcd)
 {
     // Initialiser les couleurs une seule fois
     initColors(lcd);
+    // Palettes des couches : fond uni, textes (index 0 transparent)
+    m_backgroundPalette[0] = m_backgroundPalette[1] = colBackground;
+    const uint16_t textColors[TEXT_COLOR_COUNT] = {
+        0, colCyan, colYellow, colPink, colMagenta, colWhite, colRed,
+        lcd.color565(0, 255, 0), lcd.color565(0, 0, 255), lcd.color565(0, 0, 127),
+        lcd.color565(180, 0, 255), lcd.color565(255, 0, 150), lcd.color565(20, 20, 40),
+        lcd.color565(0, 0, 0), lcd.color565(55, 16, 44), lcd.color565(85, 25, 68)};
+    std::copy(textColors, textColors + TEXT_COLOR_COUNT, m_textPalette);
     // Initialiser le prochain glitch
     m_state.glitch_next = (esp_timer_get_time() / 1000ULL) + ((esp_random() % 8000) + 7000); // 7-15 secondes
 }
@@ -49,6 +60,41 @@ void ViewBadge::updateAnimations(float dt)
     updateChipAnimation(dt);
     updateParticlesAnimation(dt);
     updateGlitchEffect(dt);
+    updatePercentAnimation(dt);
+}
+
+// Pourcentage G2S cible, basé sur le meilleur score
+static int g2sTargetPercent()
+{
+    int target_percent = 99; // Valeur par défaut si score < 1000
+    if (Config::best_score >= 1000)
+    {
+        // 100% si 1000 points, +100% pour chaque 1000 points au-dessus de 1000
+        target_percent = 100 + ((Config::best_score - 1000) / 1000) * 100;
+    }
+    return target_percent;
+}
+
+void ViewBadge::updatePercentAnimation(float dt)
+{
+    int target_percent = g2sTargetPercent();
+
+    // Animation du pourcentage G2S qui grimpe à l'arrivée
+    if (!m_state.g2s_percent_anim_started)
+    {
+        m_state.g2s_percent_anim = 0.0f;
+        m_state.g2s_percent_anim_time = 0.0f;
+        m_state.g2s_percent_anim_started = true;
+    }
+    // Incrémenter l'animation (vitesse : 5s pour atteindre la cible)
+    if (m_state.g2s_percent_anim < target_percent)
+    {
+        m_state.g2s_percent_anim_time += dt;
+        float progress = m_state.g2s_percent_anim_time / 5.0f;
+        if (progress > 1.0f)
+            progress = 1.0f;
+        m_state.g2s_percent_anim = progress * target_percent;
+    }
 }
 
 void ViewBadge::updateIntensityPulse(float dt)
@@ -213,40 +259,18 @@ void ViewBadge::updateScanlineOffset(float dt)
 
 void ViewBadge::renderBackground(LGFX_Sprite &spr)
 {
+    TRACE_SCOPE("Badge::renderBackground");
     spr.fillSprite(colBackground);
 }
 
 void ViewBadge::renderHeader(LGFX_Sprite &spr)
 {
+    TRACE_SCOPE("Badge::renderHeader");
     spr.setTextDatum(TC_DATUM);
     spr.setTextFont(1);
     spr.setTextSize(2);
 
-    // Calculer le pourcentage G2S basé sur le score
-    int target_percent = 99; // Valeur par défaut si score < 1000
-    if (Config::best_score >= 1000)
-    {
-        // 100% si 1000 points, +100% pour chaque 1000 points au-dessus de 1000
-        target_percent = 100 + ((Config::best_score - 1000) / 1000) * 100;
-    }
-
-    // Animation du pourcentage G2S qui grimpe à l'arrivée
-    if (!m_state.g2s_percent_anim_started)
-    {
-        m_state.g2s_percent_anim = 0.0f;
-        m_state.g2s_percent_anim_time = 0.0f;
-        m_state.g2s_percent_anim_started = true;
-    }
-    // Incrémenter l'animation (vitesse : 5s pour atteindre la cible)
-    if (m_state.g2s_percent_anim < target_percent)
-    {
-        m_state.g2s_percent_anim_time += m_state.dt;
-        float progress = m_state.g2s_percent_anim_time / 5.0f;
-        if (progress > 1.0f)
-            progress = 1.0f;
-        m_state.g2s_percent_anim = progress * target_percent;
-    }
-
+    int target_percent = g2sTargetPercent();
     int percent = (int)(m_state.g2s_percent_anim + 0.5f);
     if (percent > target_percent)
         percent = target_percent;
@@ -257,6 +281,7 @@ void ViewBadge::renderHeader(LGFX_Sprite &spr)
 
 void ViewBadge::renderName(LGFX_Sprite &spr)
 {
+    TRACE_SCOPE("Badge::renderName");
     renderNeonFullName(spr, user_info.prenom.c_str(), user_info.nom.c_str());
 }
 
@@ -267,6 +292,7 @@ void ViewBadge::renderSeparator(LGFX_Sprite &spr)
 
 void ViewBadge::renderTeam(LGFX_Sprite &spr)
 {
+    TRACE_SCOPE("Badge::renderTeam");
     spr.setTextDatum(TC_DATUM);
     spr.setTextFont(1);
     spr.setTextSize(2);
@@ -275,6 +301,7 @@ void ViewBadge::renderTeam(LGFX_Sprite &spr)
 
 void ViewBadge::renderLocationAndRole(LGFX_Sprite &spr)
 {
+    TRACE_SCOPE("Badge::renderLocationAndRole");
     spr.setTextDatum(TC_DATUM);
     spr.setTextFont(1);
     spr.setTextSize(2);
@@ -284,6 +311,7 @@ void ViewBadge::renderLocationAndRole(LGFX_Sprite &spr)
 
 void ViewBadge::renderModal(LGFX_Sprite &spr)
 {
+    TRACE_SCOPE("Badge::renderModal");
     if (!m_state.show_g2s_modal)
         return;
 
@@ -292,8 +320,8 @@ void ViewBadge::renderModal(LGFX_Sprite &spr)
     int modalH = 100;
     int modalX = (m_state.screenW - modalW) / 2;
     int modalY = (m_state.screenH - modalH) / 2;
-    spr.fillRect(modalX, modalY, modalW, modalH, m_lcd.color565(20, 20, 40));
-    spr.drawRect(modalX, modalY, modalW, modalH, colCyan);
+    spr.fillRect(modalX, modalY, modalW, modalH, ink(spr, m_lcd.color565(20, 20, 40)));
+    spr.drawRect(modalX, modalY, modalW, modalH, ink(spr, colCyan));
 
     // Close button (X in top-right corner)
     int closeX = modalX + modalW - 20;
@@ -301,7 +329,7 @@ void ViewBadge::renderModal(LGFX_Sprite &spr)
     spr.setTextDatum(TC_DATUM);
     spr.setTextFont(1);
     spr.setTextSize(2);
-    spr.setTextColor(colRed);
+    spr.setTextColor(ink(spr, colRed));
     spr.drawString("X", closeX, closeY);
 
     // Text
@@ -313,27 +341,35 @@ void ViewBadge::renderModal(LGFX_Sprite &spr)
     drawNeonText(spr, "100% G2S", m_state.screenW / 2, modalY + 70, colCyan);
 }
 
-void ViewBadge::renderScanlines(LGFX_Sprite &spr)
+// Scanlines CRT, décalage des lignes pendant un glitch et vignettage : appliqués par
+// DisplayManager aux lignes de la frame pendant l'envoi, plus dessinés dans le sprite
+bool ViewBadge::rowEffects(RowEffects &effects) const
 {
-    // Dessiner les scanlines avec défilement fluide
-    uint16_t col = m_lcd.color565(12, 8, 30);
-
-    // Espacement entre les scanlines
-    const int spacing = 10;
-
-    // Calculer l'offset avec modulo pour créer un cycle continu
-    int baseOffset = (int)m_state.scanline_offset % spacing;
+    // Scanlines qui défilent (sauf en qualité minimale), une ligne sur 10
+    if (m_state.quality > 0)
+    {
+        effects.scanlineSpacing = 10;
+        effects.scanlineOffset = (int)m_state.scanline_offset % 10;
+        effects.scanlineDarken = 3;
+    }
 
-    // Dessiner les lignes stationnaires (pas d'animation)
-    for (int y = baseOffset; y < m_state.screenH; y += spacing)
+    // Glitch : tranches de lignes décalées, nouveau tirage à chaque frame
+    if (m_state.glitch_active)
     {
-        spr.drawFastHLine(0, y, m_state.screenW, col);
+        effects.glitchAmplitude = 4 + 2 * std::abs(m_state.glitch_offset_x);
+        effects.glitchSlice = 6 + m_state.glitch_offset_y;
+        effects.glitchSeed = esp_random();
     }
+
+    if (m_state.quality >= 2)
+        effects.vignette = 12;
+    return true;
 }
 
-void ViewBadge::renderCorners(LGFX_Sprite &spr, uint8_t intensity)
+void ViewBadge::renderCorners(LGFX_Sprite &spr)
 {
-    uint16_t cornerColor = m_lcd.color565(intensity * 0.7, intensity * 0.8, intensity);
+    TRACE_SCOPE("Badge::renderCorners");
+    uint16_t cornerColor = decorColor(spr, DECOR_CORNER);
 
     int cornerSize = 15;
     int thickness = 2;
@@ -357,46 +393,17 @@ void ViewBadge::renderCorners(LGFX_Sprite &spr, uint8_t intensity)
 
 void ViewBadge::renderParticles(LGFX_Sprite &spr)
 {
-    // Dessiner toutes les particules actives (jusqu'à 12)
-    for (int i = 0; i < 12; i++)
+    TRACE_SCOPE("Badge::renderParticles");
+    // Dessiner les particules actives (jusqu'à 12, moins quand la qualité baisse)
+    const int count = PARTICLE_COUNT * m_state.quality / QualityController::LEVEL_MAX;
+    for (int i = 0; i < count; i++)
     {
         // Ne dessiner que les particules actives avec alpha visible
         if (!m_state.particles[i].active || m_state.particles[i].alpha < 0.05f)
             continue;
 
-        // Variantes de cyan uniquement
-        uint8_t r, g, b;
-
-        // Alterner entre différentes nuances de cyan
-        int color_index = i % 3;
-        if (color_index == 0)
-        {
-            // Cyan pur brillant
-            r = 0;
-            g = 255;
-            b = 255;
-        }
-        else if (color_index == 1)
-        {
-            // Cyan électrique (plus de bleu)
-            r = 0;
-            g = 200;
-            b = 255;
-        }
-        else
-        {
-            // Cyan doux (plus de vert)
-            r = 100;
-            g = 255;
-            b = 200;
-        }
-
-        // Appliquer l'alpha pour le fade in/out
-        float brightness = m_state.particles[i].alpha;
-        uint16_t particleColor = m_lcd.color565(
-            r * brightness,
-            g * brightness,
-            b * brightness);
+        // Nuance et fondu de la particule : son entrée de la palette du décor
+        uint16_t particleColor = decorColor(spr, m_particleColors[i]);
 
         int x = (int)m_state.particles[i].x;
         int y = (int)m_state.particles[i].y;
@@ -415,19 +422,20 @@ void ViewBadge::renderParticles(LGFX_Sprite &spr)
     }
 }
 
-void ViewBadge::renderBorders(LGFX_Sprite &spr, uint8_t intensity)
+void ViewBadge::renderBorders(LGFX_Sprite &spr)
 {
-    uint16_t borderColor = m_lcd.color565(intensity * 0.9, intensity * 0.6, intensity);
+    TRACE_SCOPE("Badge::renderBorders");
+    uint16_t borderColor = decorColor(spr, DECOR_BORDER);
 
     // Bordures fines avec effet de lueur
     spr.drawRect(2, 2, m_state.screenW - 4, m_state.screenH - 4, borderColor);
 
     // Effet de double bordure pour plus de profondeur
-    uint16_t borderColor2 = m_lcd.color565(intensity * 0.5, intensity * 0.3, intensity * 0.6);
+    uint16_t borderColor2 = decorColor(spr, DECOR_BORDER_DIM);
     spr.drawRect(1, 1, m_state.screenW - 2, m_state.screenH - 2, borderColor2);
 }
 
-void ViewBadge::drawTriangle(LGFX_Sprite &spr, int cornerX, int cornerY, bool pointRight, bool pointDown, int triSize, uint8_t intensity, uint16_t geomColor)
+void ViewBadge::drawTriangle(LGFX_Sprite &spr, int cornerX, int cornerY, bool pointRight, bool pointDown, int triSize, uint16_t geomColor)
 {
     // Triangle rectangle pointant vers le centre de l'écran
     int x1 = cornerX;
@@ -445,7 +453,7 @@ void ViewBadge::drawTriangle(LGFX_Sprite &spr, int cornerX, int cornerY, bool po
     // Ligne intérieure pour effet de remplissage partiel
     if (triSize > 4)
     {
-        uint16_t innerColor = m_lcd.color565(intensity * 0.3, intensity * 0.6, intensity * 0.5);
+        uint16_t innerColor = decorColor(spr, DECOR_GEOM_DIM);
         int innerSize = triSize - 3;
         int ix2 = pointRight ? cornerX + innerSize : cornerX - innerSize;
         int iy3 = pointDown ? cornerY + innerSize : cornerY - innerSize;
@@ -454,25 +462,25 @@ void ViewBadge::drawTriangle(LGFX_Sprite &spr, int cornerX, int cornerY, bool po
     }
 }
 
-void ViewBadge::renderCornerTriangles(LGFX_Sprite &spr, uint8_t intensity, uint16_t geomColor)
+void ViewBadge::renderCornerTriangles(LGFX_Sprite &spr, uint16_t geomColor)
 {
     int triSize = 8;
     int cornerOffset = 10;
 
     // Triangle haut-gauche (pointe vers bas-droit)
-    drawTriangle(spr, cornerOffset, cornerOffset, true, true, triSize, intensity, geomColor);
+    drawTriangle(spr, cornerOffset, cornerOffset, true, true, triSize, geomColor);
 
     // Triangle haut-droit (pointe vers bas-gauche)
-    drawTriangle(spr, m_state.screenW - cornerOffset, cornerOffset, false, true, triSize, intensity, geomColor);
+    drawTriangle(spr, m_state.screenW - cornerOffset, cornerOffset, false, true, triSize, geomColor);
 
     // Triangle bas-gauche (pointe vers haut-droit)
-    drawTriangle(spr, cornerOffset, m_state.screenH - cornerOffset, true, false, triSize, intensity, geomColor);
+    drawTriangle(spr, cornerOffset, m_state.screenH - cornerOffset, true, false, triSize, geomColor);
 
     // Triangle bas-droit (pointe vers haut-gauche)
-    drawTriangle(spr, m_state.screenW - cornerOffset, m_state.screenH - cornerOffset, false, false, triSize, intensity, geomColor);
+    drawTriangle(spr, m_state.screenW - cornerOffset, m_state.screenH - cornerOffset, false, false, triSize, geomColor);
 }
 
-void ViewBadge::renderAnimatedLines(LGFX_Sprite &spr, uint8_t intensity, uint16_t geomColor)
+void ViewBadge::renderAnimatedLines(LGFX_Sprite &spr, uint16_t geomColor)
 {
     int lineY1 = 40;
 
@@ -493,7 +501,7 @@ void ViewBadge::renderAnimatedLines(LGFX_Sprite &spr, uint8_t intensity, uint16_
     float lineLen2_right = baseLen + (-wave2 * maxExtension);
 
     // Effet de double ligne pour plus de profondeur
-    uint16_t geomColorDim = m_lcd.color565(intensity * 0.3, intensity * 0.6, intensity * 0.5);
+    uint16_t geomColorDim = decorColor(spr, DECOR_GEOM_DIM);
 
     // Utiliser floor() pour un arrondi cohérent vers le bas (pas de sauts de 2-3 pixels)
     int len1_left = (int)floorf(lineLen1_left);
@@ -518,36 +526,26 @@ void ViewBadge::renderAnimatedLines(LGFX_Sprite &spr, uint8_t intensity, uint16_
     spr.drawFastHLine(m_state.screenW - 10 - len2_right_dim, m_state.screenH - lineY1 - 2, len2_right_dim, geomColorDim);
 }
 
-void ViewBadge::renderGeometricElements(LGFX_Sprite &spr, uint8_t intensity)
+void ViewBadge::renderGeometricElements(LGFX_Sprite &spr)
 {
-    uint16_t geomColor = m_lcd.color565(intensity * 0.5, intensity, intensity * 0.8);
+    TRACE_SCOPE("Badge::renderGeometricElements");
+    uint16_t geomColor = decorColor(spr, DECOR_GEOM);
 
-    renderCornerTriangles(spr, intensity, geomColor);
-    renderAnimatedLines(spr, intensity, geomColor);
+    renderCornerTriangles(spr, geomColor);
+    renderAnimatedLines(spr, geomColor);
 }
 
 void ViewBadge::renderMicroprocessor(LGFX_Sprite &spr)
 {
+    TRACE_SCOPE("Badge::renderMicroprocessor");
     // Ne rien dessiner si complètement invisible ou si le fondu est presque terminé
     if (m_state.chip_fade_alpha <= 0.05f)
     {
         return;
     }
 
-    // Interpolation entre la couleur cyan (0, 224, 255) et la couleur du background (6, 4, 16)
-    uint8_t bgR = 6;
-    uint8_t bgG = 4;
-    uint8_t bgB = 16;
-    uint8_t cyanR = 0;
-    uint8_t cyanG = 224;
-    uint8_t cyanB = 255;
-
-    // Interpoler selon chip_fade_alpha : alpha=1.0 = cyan pur, alpha=0.0 = background
-    float alpha = m_state.chip_fade_alpha;
-    uint8_t redComponent = (uint8_t)(cyanR * alpha + bgR * (1.0f - alpha));
-    uint8_t greenComponent = (uint8_t)(cyanG * alpha + bgG * (1.0f - alpha));
-    uint8_t blueComponent = (uint8_t)(cyanB * alpha + bgB * (1.0f - alpha));
-    uint16_t chipColor = m_lcd.color565(redComponent, greenComponent, blueComponent);
+    // Couleur du fondu (voir updateDecorPalette)
+    uint16_t chipColor = decorColor(spr, DECOR_CHIP);
 
     // Position centrale en bas de l'écran
     int centerX = m_state.screenW / 2;
@@ -697,9 +695,7 @@ void ViewBadge::renderNeonFullName(LGFX_Sprite &spr, const char *name1, const ch
 // Helper pour effet néon simple sur un texte
 void ViewBadge::drawNeonText(LGFX_Sprite &spr, const char *text, int x, int y, uint16_t baseColor)
 {
-    // Appliquer le glitch si actif
-    int glitch_x = m_state.glitch_active ? m_state.glitch_offset_x : 0;
-    int glitch_y = m_state.glitch_active ? m_state.glitch_offset_y : 0;
+    // Le décalage du glitch est appliqué à l'envoi (rowEffects) ; seule la séparation RGB est dessinée
 
     // Effet glitch intensif : corruption de buffer avec séparation RGB extrême
     if (m_state.glitch_active)
@@ -714,17 +710,17 @@ void ViewBadge::drawNeonText(LGFX_Sprite &spr, const char *text, int x, int y, u
 
         // Canal ROUGE ultra-décalé (effet mémoire corrompue)
         uint16_t redChannel = m_lcd.color565(255, 0, 0);
-        spr.setTextColor(redChannel);
+        spr.setTextColor(ink(spr, redChannel));
         spr.drawString(text, x + red_offset_x - 2, y + red_offset_y);
 
         // Canal VERT (offset moyen, simule le bug du milieu)
         uint16_t greenChannel = m_lcd.color565(0, 255, 0);
-        spr.setTextColor(greenChannel);
+        spr.setTextColor(ink(spr, greenChannel));
         spr.drawString(text, x + green_offset_x, y + green_offset_y);
 
         // Canal BLEU ultra-décalé (à l'opposé du rouge)
         uint16_t blueChannel = m_lcd.color565(0, 0, 255);
-        spr.setTextColor(blueChannel);
+        spr.setTextColor(ink(spr, blueChannel));
         spr.drawString(text, x + blue_offset_x + 2, y + blue_offset_y);
 
         // Lignes horizontales "corrompues" (effet scan line bug)
@@ -733,17 +729,19 @@ void ViewBadge::drawNeonText(LGFX_Sprite &spr, const char *text, int x, int y, u
             (esp_random() % 2) * 255,
             (esp_random() % 2) * 255,
             (esp_random() % 2) * 255);
-        spr.setTextColor(scanColor);
+        spr.setTextColor(ink(spr, scanColor));
         spr.drawString(text, x + ((esp_random() % 3) - 1), scan_y);
 
         // "Fantômes" multiples (effet de buffer overflow)
-        for (int ghost = 0; ghost < 2; ghost++)
+        // Fantômes supprimés quand le rendu dépasse son budget
+        int ghosts = m_state.quality >= 2 ? 2 : 0;
+        for (int ghost = 0; ghost < ghosts; ghost++)
         {
             int ghost_x = ((esp_random() % 7) - 3);
             int ghost_y = ((esp_random() % 5) - 2);
             uint8_t ghost_alpha = (40 + (esp_random() % 60));
             uint16_t ghostColor = m_lcd.color565(ghost_alpha, ghost_alpha * 0.3, ghost_alpha * 0.8);
-            spr.setTextColor(ghostColor);
+            spr.setTextColor(ink(spr, ghostColor));
             spr.drawString(text, x + ghost_x, y + ghost_y);
         }
     }
@@ -772,22 +770,21 @@ void ViewBadge::drawNeonText(LGFX_Sprite &spr, const char *text, int x, int y, u
         shadowColor = m_lcd.color565(180, 0, 255);
     }
 
-    // Ombre/glow décalée
-    spr.setTextColor(shadowColor);
-    spr.drawString(text, x + glitch_x + 1, y + glitch_y + 1);
+    // Ombre/glow décalée (seconde passe de texte, omise en qualité minimale)
+    if (m_state.quality > 0)
+    {
+        spr.setTextColor(ink(spr, shadowColor));
+        spr.drawString(text, x + 1, y + 1);
+    }
 
     // Texte principal avec intensité variable
-    spr.setTextColor(baseColor);
-    spr.drawString(text, x + glitch_x, y + glitch_y);
+    spr.setTextColor(ink(spr, baseColor));
+    spr.drawString(text, x, y);
 }
 
 // Helper pour effet néon sur une ligne
 void ViewBadge::drawNeonLine(LGFX_Sprite &spr, int x1, int y1, int x2, int y2, uint16_t baseColor)
 {
-    // Appliquer le glitch si actif
-    int glitch_x = m_state.glitch_active ? m_state.glitch_offset_x : 0;
-    int glitch_y = m_state.glitch_active ? m_state.glitch_offset_y : 0;
-
     // Extraire les composantes RGB
     uint8_t baseR = ((baseColor >> 11) & 0x1F) * 8;
     uint8_t baseB = (baseColor & 0x1F) * 8;
@@ -796,53 +793,356 @@ void ViewBadge::drawNeonLine(LGFX_Sprite &spr, int x1, int y1, int x2, int y2, u
     if (m_state.glitch_active)
     {
         uint16_t redChannel = m_lcd.color565(baseR * 0.5, 0, 0);
-        spr.drawFastHLine(x1 + glitch_x - 2, y1 + glitch_y, x2 - x1, redChannel);
+        spr.drawFastHLine(x1 - 2, y1, x2 - x1, ink(spr, redChannel));
 
         uint16_t blueChannel = m_lcd.color565(0, 0, baseB * 0.5);
-        spr.drawFastHLine(x1 + glitch_x + 2, y1 + glitch_y, x2 - x1, blueChannel);
+        spr.drawFastHLine(x1 + 2, y1, x2 - x1, ink(spr, blueChannel));
     }
 
     // Effet néon simple : ombre/glow décalée
     uint16_t shadowColor = m_lcd.color565(255, 0, 150); // Magenta néon
 
     // Ombre décalée
-    spr.drawFastHLine(x1 + glitch_x, y1 + glitch_y + 1, x2 - x1, shadowColor);
+    spr.drawFastHLine(x1, y1 + 1, x2 - x1, ink(spr, shadowColor));
 
     // Ligne principale avec intensité variable
-    spr.drawFastHLine(x1 + glitch_x, y1 + glitch_y, x2 - x1, baseColor);
+    spr.drawFastHLine(x1, y1, x2 - x1, ink(spr, baseColor));
 }
 
 // Affichage principal du badge
-void ViewBadge::render(LGFX &display, LGFX_Sprite &spr)
+void ViewBadge::update(float dt)
 {
-
     // Initialiser les particules si nécessaire
     initParticles();
 
-    // Utiliser le delta time calculé globalement par DisplayManager
-    float dt = m_state.dt;
-
     // Mise à jour des animations
     updateAnimations(dt);
+}
+
+// Rendu complet dans un sprite 16 bits, quand les couches n'ont pas pu être allouées
+void ViewBadge::render(LGFX &display, LGFX_Sprite &spr)
+{
+    updateDecorPalette();
+
+    // Rendu en couches (de l'arrière vers l'avant)
+    renderBackground(spr); // Fond sombre
+    renderDecor(spr);      // Particules, éléments géométriques, bordures, microprocesseur
+    renderTexts(spr);      // Titre, nom, équipe, ville et poste, modale
+
+    reportDamage();
+}
+
+LayerInfo ViewBadge::layerInfo(int layer) const
+{
+    switch (layer)
+    {
+    case LAYER_BACKGROUND:
+        return {1, m_backgroundPalette, 2, -1};
+    case LAYER_DECOR:
+        return {4, m_decorPalette, DECOR_COLOR_COUNT, DECOR_TRANSPARENT};
+    default:
+        return {4, m_textPalette, TEXT_COLOR_COUNT, TEXT_TRANSPARENT};
+    }
+}
+
+void ViewBadge::renderLayer(int layer, LGFX_Sprite &spr, bool full)
+{
+    switch (layer)
+    {
+    case LAYER_BACKGROUND:
+        // Fond uni : dessiné une seule fois
+        if (full)
+            spr.fillSprite(0);
+        break;
+    case LAYER_DECOR:
+        renderDecorLayer(spr, full);
+        break;
+    case LAYER_TEXT:
+        renderTextLayer(spr, full);
+        break;
+    }
+}
+
+// Décor : la pulsation et les fondus ne changent que la palette, seuls les éléments qui
+// bougent (particules, lignes animées, tracé du microprocesseur) sont effacés puis redessinés
+void ViewBadge::renderDecorLayer(LGFX_Sprite &spr, bool full)
+{
+    TRACE_SCOPE("Badge::renderDecorLayer");
+    const int W = m_state.screenW;
+    const int H = m_state.screenH;
+    updateDecorPalette();
+
+    bool chipVisible = m_state.chip_fade_alpha > 0.05f;
+    bool chipMoved = chipVisible != m_lastChipVisible || m_state.chip_animation_progress != m_lastChipProgress;
+    bool chipFaded = m_state.chip_fade_alpha != m_lastChipAlpha;
+    m_lastChipVisible = chipVisible;
+    m_lastChipProgress = m_state.chip_animation_progress;
+    m_lastChipAlpha = m_state.chip_fade_alpha;
+
+    const DamageRect lines[4] = {{10, 38, 46, 5}, {W - 56, 38, 46, 5}, {10, H - 42, 46, 5}, {W - 56, H - 42, 46, 5}};
+    const DamageRect chip = {W / 2 - 33, H - 46, 67, 33};
+
+    if (full)
+    {
+        spr.fillSprite(DECOR_TRANSPARENT);
+        addFullDamage();
+    }
+    else
+    {
+        for (const DamageRect &r : m_lastParticles)
+            spr.fillRect(r.x, r.y, r.w, r.h, DECOR_TRANSPARENT);
+        for (const DamageRect &r : lines)
+            spr.fillRect(r.x, r.y, r.w, r.h, DECOR_TRANSPARENT);
+        if (chipMoved)
+            spr.fillRect(chip.x, chip.y, chip.w, chip.h, DECOR_TRANSPARENT);
+    }
+
+    // Tout le décor est redessiné (quelques centaines de pixels) : ce que l'effacement des
+    // particules a pu toucher réapparaît
+    renderDecor(spr);
+
+    addParticlesDamage(full);
+    if (full)
+        return;
+
+    // Bandeaux du pourtour : bordures, coins et triangles pulsent à chaque frame (palette)
+    const int edge = 23;
+    addDamage(0, 0, W, edge);
+    addDamage(0, H - edge, W, edge);
+    addDamage(0, edge, edge, H - 2 * edge);
+    addDamage(W - edge, edge, edge, H - 2 * edge);
+    for (const DamageRect &r : lines)
+        addDamage(r.x, r.y, r.w, r.h);
+    if (chipMoved || chipFaded)
+        addDamage(chip.x, chip.y, chip.w, chip.h);
+}
+
+// Textes : redessinés seulement pendant un glitch, à l'ouverture de la modale, quand la
+// qualité change ou pendant l'animation du pourcentage (titre seul)
+void ViewBadge::renderTextLayer(LGFX_Sprite &spr, bool full)
+{
+    TRACE_SCOPE("Badge::renderTextLayer");
+    int percent = (int)(m_state.g2s_percent_anim + 0.5f);
+    bool redraw = full || m_state.glitch_active || m_lastGlitch || m_state.show_g2s_modal != m_lastModal ||
+                  m_state.quality != m_lastQuality;
+    bool percentChanged = percent != m_lastPercent;
+    m_lastPercent = percent;
+    m_lastGlitch = m_state.glitch_active;
+    m_lastModal = m_state.show_g2s_modal;
+    m_lastQuality = m_state.quality;
+
+    if (redraw)
+    {
+        spr.fillSprite(TEXT_TRANSPARENT);
+        renderTexts(spr);
+        addFullDamage();
+    }
+    else if (percentChanged)
+    {
+        const DamageRect header = {m_state.screenW / 2 - 60, 18, 120, 22};
+        spr.fillRect(header.x, header.y, header.w, header.h, TEXT_TRANSPARENT);
+        renderHeader(spr);
+        addDamage(header.x, header.y, header.w, header.h);
+    }
+}
+
+void ViewBadge::renderDecor(LGFX_Sprite &spr)
+{
+    renderParticles(spr);         // Particules flottantes
+    renderGeometricElements(spr); // Éléments géométriques décoratifs
+    renderBorders(spr);           // Bordures pulsantes
+    renderCorners(spr);           // Coins décoratifs
+    renderMicroprocessor(spr);    // Animation du microprocesseur
+}
+
+void ViewBadge::renderTexts(LGFX_Sprite &spr)
+{
+    renderHeader(spr);          // Titre "100% G2S" animé
+    renderName(spr);            // Nom avec effet néon
+    renderSeparator(spr);       // Ligne de séparation
+    renderTeam(spr);            // Équipe
+    renderLocationAndRole(spr); // Ville et poste
+    renderModal(spr);           // Modal si affiché
+}
 
+// Écart entre deux couleurs RGB565 (vert ramené sur 5 bits)
+static int colorDistance(uint16_t a, uint16_t b)
+{
+    int dr = ((a >> 11) & 0x1F) - ((b >> 11) & 0x1F);
+    int dg = (((a >> 5) & 0x3F) - ((b >> 5) & 0x3F)) / 2;
+    int db = (a & 0x1F) - (b & 0x1F);
+    return dr * dr + dg * dg + db * db;
+}
+
+// Couleurs animées du décor : pulsation commune, fondu du microprocesseur, nuance et
+// fondu de chaque particule
+void ViewBadge::updateDecorPalette()
+{
     // Calculer l'intensité commune basée sur intensity_pulse
     float pulse = (sinf(m_state.intensity_pulse) * 0.5f + 0.5f);
     uint8_t intensity = (uint8_t)(100 + pulse * 155);
 
-    // Rendu en couches (de l'arrière vers l'avant)
-    renderBackground(spr);                   // Fond sombre
-    renderScanlines(spr);                    // Lignes de scan CRT
-    renderParticles(spr);                    // Particules flottantes
-    renderGeometricElements(spr, intensity); // Éléments géométriques décoratifs
-    renderBorders(spr, intensity);           // Bordures pulsantes
-    renderCorners(spr, intensity);           // Coins décoratifs
-    renderMicroprocessor(spr);               // Animation du microprocesseur
-    renderHeader(spr);                       // Titre "100% G2S" animé
-    renderName(spr);                         // Nom avec effet néon
-    renderSeparator(spr);                    // Ligne de séparation
-    renderTeam(spr);                         // Équipe
-    renderLocationAndRole(spr);              // Ville et poste
-    renderModal(spr);                        // Modal si affiché
+    m_decorPalette[DECOR_TRANSPARENT] = 0;
+    m_decorPalette[DECOR_BORDER] = m_lcd.color565(intensity * 0.9, intensity * 0.6, intensity);
+    m_decorPalette[DECOR_BORDER_DIM] = m_lcd.color565(intensity * 0.5, intensity * 0.3, intensity * 0.6);
+    m_decorPalette[DECOR_CORNER] = m_lcd.color565(intensity * 0.7, intensity * 0.8, intensity);
+    m_decorPalette[DECOR_GEOM] = m_lcd.color565(intensity * 0.5, intensity, intensity * 0.8);
+    m_decorPalette[DECOR_GEOM_DIM] = m_lcd.color565(intensity * 0.3, intensity * 0.6, intensity * 0.5);
+
+    // Interpolation entre la couleur cyan (0, 224, 255) et la couleur du background (6, 4, 16)
+    // selon chip_fade_alpha : alpha=1.0 = cyan pur, alpha=0.0 = background
+    float alpha = m_state.chip_fade_alpha;
+    m_decorPalette[DECOR_CHIP] = m_lcd.color565((uint8_t)(0 * alpha + 6 * (1.0f - alpha)),
+                                                (uint8_t)(224 * alpha + 4 * (1.0f - alpha)),
+                                                (uint8_t)(255 * alpha + 16 * (1.0f - alpha)));
+
+    // Variantes de cyan uniquement : pur brillant, électrique (plus de bleu), doux (plus de vert)
+    // Chaque particule visible prend une entrée libre ; au-delà de DECOR_PARTICLE_SLOTS, elle
+    // reprend la plus proche de sa couleur. Les particules étant redessinées à chaque frame,
+    // l'attribution peut changer d'une frame à l'autre.
+    static const uint8_t shades[3][3] = {{0, 255, 255}, {0, 200, 255}, {100, 255, 200}};
+    int slots = 0;
+    for (int i = 0; i < PARTICLE_COUNT; i++)
+    {
+        if (particleRect(i).w == 0)
+            continue;
+        // Appliquer l'alpha pour le fade in/out
+        const uint8_t *shade = shades[i % 3];
+        float brightness = m_state.particles[i].alpha;
+        uint16_t color = m_lcd.color565(shade[0] * brightness, shade[1] * brightness, shade[2] * brightness);
+        if (slots < DECOR_PARTICLE_SLOTS)
+        {
+            m_particleColors[i] = DECOR_PARTICLE + slots++;
+            m_decorPalette[m_particleColors[i]] = color;
+            continue;
+        }
+        int best = DECOR_PARTICLE;
+        for (int slot = DECOR_PARTICLE + 1; slot < DECOR_COLOR_COUNT; slot++)
+        {
+            if (colorDistance(m_decorPalette[slot], color) < colorDistance(m_decorPalette[best], color))
+                best = slot;
+        }
+        m_particleColors[i] = best;
+    }
+}
+
+// Couleur à passer aux primitives du décor : index dans la couche, RGB565 dans un sprite 16 bits
+uint16_t ViewBadge::decorColor(LGFX_Sprite &spr, int index) const
+{
+    return spr.hasPalette() ? (uint16_t)index : m_decorPalette[index];
+}
+
+// Couleur à passer aux primitives des textes : dans la couche, l'entrée la plus proche de
+// sa palette (les couleurs du glitch n'y sont qu'approchées)
+uint16_t ViewBadge::ink(LGFX_Sprite &spr, uint16_t color) const
+{
+    if (!spr.hasPalette())
+        return color;
+
+    int best = TEXT_TRANSPARENT + 1;
+    int bestDistance = -1;
+    for (int i = TEXT_TRANSPARENT + 1; i < TEXT_COLOR_COUNT; i++)
+    {
+        int distance = colorDistance(m_textPalette[i], color);
+        if (bestDistance < 0 || distance < bestDistance)
+        {
+            best = i;
+            bestDistance = distance;
+        }
+    }
+    return (uint16_t)best;
+}
+
+// Zone de la particule i dessinée à cette frame (vide si elle ne l'est pas)
+DamageRect ViewBadge::particleRect(int i) const
+{
+    const int count = PARTICLE_COUNT * m_state.quality / QualityController::LEVEL_MAX;
+    const Particle &p = m_state.particles[i];
+    if (i >= count || !p.active || p.alpha < 0.05f)
+        return {0, 0, 0, 0};
+    int size = (int)p.size;
+    int half = size / 2;
+    return {(int)p.x - half - 1, (int)p.y - half - 1, size + 2, size + 2};
+}
+
+// Particules : union de l'ancienne et de la nouvelle position (sauf si toute la frame est
+// déjà signalée), puis mémorisation des positions de cette frame
+void ViewBadge::addParticlesDamage(bool fullFrame)
+{
+    for (int i = 0; i < PARTICLE_COUNT; i++)
+    {
+        DamageRect current = particleRect(i);
+        const DamageRect &last = m_lastParticles[i];
+        if (!fullFrame)
+        {
+            if (current.w > 0 && last.w > 0)
+            {
+                int x0 = std::min(current.x, last.x);
+                int y0 = std::min(current.y, last.y);
+                int x1 = std::max(current.x + current.w, last.x + last.w);
+                int y1 = std::max(current.y + current.h, last.y + last.h);
+                addDamage(x0, y0, x1 - x0, y1 - y0);
+            }
+            else
+            {
+                addDamage(current.x, current.y, current.w, current.h);
+                addDamage(last.x, last.y, last.w, last.h);
+            }
+        }
+        m_lastParticles[i] = current;
+    }
+}
+
+// Signale à DisplayManager les zones animées de cette frame
+void ViewBadge::reportDamage()
+{
+    const int W = m_state.screenW;
+    const int H = m_state.screenH;
+
+    // Le glitch, la modale et un changement de qualité touchent tout l'écran (les scanlines
+    // ne sont plus dans le sprite : appliquées à l'envoi, qui repasse alors toute la frame)
+    bool fullFrame = m_state.glitch_active || m_lastGlitch ||
+                     m_state.show_g2s_modal != m_lastModal || m_state.quality != m_lastQuality;
+    m_lastQuality = m_state.quality;
+    m_lastGlitch = m_state.glitch_active;
+    m_lastModal = m_state.show_g2s_modal;
+
+    addParticlesDamage(fullFrame);
+
+    int percent = (int)(m_state.g2s_percent_anim + 0.5f);
+    bool percentChanged = percent != m_lastPercent;
+    bool chipChanged = m_state.chip_animation_progress != m_lastChipProgress ||
+                       m_state.chip_fade_alpha != m_lastChipAlpha;
+    m_lastPercent = percent;
+    m_lastChipProgress = m_state.chip_animation_progress;
+    m_lastChipAlpha = m_state.chip_fade_alpha;
+
+    if (fullFrame)
+    {
+        addFullDamage();
+        return;
+    }
+
+    // Bandeaux du pourtour : bordures, coins et triangles pulsent à chaque frame
+    const int edge = 23;
+    addDamage(0, 0, W, edge);
+    addDamage(0, H - edge, W, edge);
+    addDamage(0, edge, edge, H - 2 * edge);
+    addDamage(W - edge, edge, edge, H - 2 * edge);
+
+    // Lignes animées (longueur max 45 px), en haut et en bas
+    addDamage(10, 38, 46, 5);
+    addDamage(W - 56, 38, 46, 5);
+    addDamage(10, H - 42, 46, 5);
+    addDamage(W - 56, H - 42, 46, 5);
+
+    // Pourcentage G2S en cours d'animation
+    if (percentChanged)
+        addDamage(W / 2 - 60, 18, 120, 22);
+
+    // Microprocesseur (pins comprises)
+    if (chipChanged)
+        addDamage(W / 2 - 33, H - 46, 67, 33);
 }
 
 bool ViewBadge::handleTouch(int x, int y)
@@ -11,8 +11,45 @@ class ViewBadge : public View
 public:
     ViewBadge(AppState &state, LGFX &lcd);
     void render(LGFX &display, LGFX_Sprite &spr) override;
+    void update(float dt) override;
     bool handleTouch(int x, int y) override;
     void onExitView() override;
+    const char *getName() const override { return "Badge"; }
+    int targetFps() const override { return 30; }
+    bool reportsDamage() const override { return true; }
+    bool rowEffects(RowEffects &effects) const override;
+    int layerCount() const override { return LAYER_COUNT; }
+    LayerInfo layerInfo(int layer) const override;
+    void renderLayer(int layer, LGFX_Sprite &spr, bool full) override;
+
+    static const int PARTICLE_COUNT = 12;
+
+    // Couches composées par DisplayManager : fond uni (1 bit), décor animé et textes (4 bits)
+    enum Layer
+    {
+        LAYER_BACKGROUND,
+        LAYER_DECOR,
+        LAYER_TEXT,
+        LAYER_COUNT
+    };
+    // Palette du décor : la pulsation, le fondu du microprocesseur et celui de chaque particule
+    // sont des couleurs animées, sans redessiner les pixels. Les particules visibles se
+    // partagent les entrées restantes pour que le décor tienne en 4 bits.
+    enum DecorColor
+    {
+        DECOR_TRANSPARENT,
+        DECOR_BORDER,
+        DECOR_BORDER_DIM,
+        DECOR_CORNER,
+        DECOR_GEOM,
+        DECOR_GEOM_DIM,
+        DECOR_CHIP,
+        DECOR_PARTICLE,
+        DECOR_COLOR_COUNT = 16,
+        DECOR_PARTICLE_SLOTS = DECOR_COLOR_COUNT - DECOR_PARTICLE
+    };
+    static const int TEXT_TRANSPARENT = 0;
+    static const int TEXT_COLOR_COUNT = 16;
 
     void initParticles();
     void updateAnimations(float dt);
@@ -21,30 +58,55 @@ public:
     void updateParticlesAnimation(float dt);
     void updateGlitchEffect(float dt);
     void updateScanlineOffset(float dt);
+    void updatePercentAnimation(float dt);
     void renderBackground(LGFX_Sprite &spr);
     void renderHeader(LGFX_Sprite &spr);
     void renderName(LGFX_Sprite &spr);
     void renderSeparator(LGFX_Sprite &spr);
     void renderTeam(LGFX_Sprite &spr);
     void renderLocationAndRole(LGFX_Sprite &spr);
-    void renderScanlines(LGFX_Sprite &spr);
     void renderNeonFullName(LGFX_Sprite &spr, const char *name1, const char *name2);
-    void renderCorners(LGFX_Sprite &spr, uint8_t intensity);
+    void renderCorners(LGFX_Sprite &spr);
     void renderParticles(LGFX_Sprite &spr);
-    void renderBorders(LGFX_Sprite &spr, uint8_t intensity);
-    void renderGeometricElements(LGFX_Sprite &spr, uint8_t intensity);
-    void renderCornerTriangles(LGFX_Sprite &spr, uint8_t intensity, uint16_t geomColor);
-    void renderAnimatedLines(LGFX_Sprite &spr, uint8_t intensity, uint16_t geomColor);
+    void renderBorders(LGFX_Sprite &spr);
+    void renderGeometricElements(LGFX_Sprite &spr);
+    void renderCornerTriangles(LGFX_Sprite &spr, uint16_t geomColor);
+    void renderAnimatedLines(LGFX_Sprite &spr, uint16_t geomColor);
     void renderMicroprocessor(LGFX_Sprite &spr);
+    void renderDecor(LGFX_Sprite &spr);
+    void renderTexts(LGFX_Sprite &spr);
+    void renderDecorLayer(LGFX_Sprite &spr, bool full);
+    void renderTextLayer(LGFX_Sprite &spr, bool full);
+    void updateDecorPalette();
+    uint16_t decorColor(LGFX_Sprite &spr, int index) const;
+    uint16_t ink(LGFX_Sprite &spr, uint16_t color) const;
 
     // Helper pour effets néon
     void drawNeonText(LGFX_Sprite &spr, const char *text, int x, int y, uint16_t baseColor);
     void drawNeonLine(LGFX_Sprite &spr, int x1, int y1, int x2, int y2, uint16_t baseColor);
-    void drawTriangle(LGFX_Sprite &spr, int cornerX, int cornerY, bool pointRight, bool pointDown, int triSize, uint8_t intensity, uint16_t geomColor);
+    void drawTriangle(LGFX_Sprite &spr, int cornerX, int cornerY, bool pointRight, bool pointDown, int triSize, uint16_t geomColor);
     void renderModal(LGFX_Sprite &spr);
+    void reportDamage();
+    DamageRect particleRect(int i) const;
+    void addParticlesDamage(bool fullFrame);
 
     AppState &m_state;
     LGFX &m_lcd;
+
+    // État du rendu précédent, pour ne signaler que les zones qui ont changé
+    int m_lastPercent = -1;
+    bool m_lastGlitch = false;
+    bool m_lastModal = false;
+    int m_lastQuality = -1;
+    float m_lastChipProgress = -1.0f;
+    float m_lastChipAlpha = -1.0f;
+    bool m_lastChipVisible = false;
+    DamageRect m_lastParticles[PARTICLE_COUNT] = {};
+    uint8_t m_particleColors[PARTICLE_COUNT] = {}; // Entrée de la palette du décor de chaque particule
+
+    uint16_t m_backgroundPalette[2];
+    uint16_t m_decorPalette[DECOR_COLOR_COUNT] = {};
+    uint16_t m_textPalette[TEXT_COLOR_COUNT];
 };
 
 #endif // VIEW_BADGE_H
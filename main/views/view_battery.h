@@ -9,6 +9,8 @@ class ViewBattery : public View
 public:
     ViewBattery(BatteryMonitor *monitor) : View(true), m_monitor(monitor) {}
     void render(LGFX &display, LGFX_Sprite &spr) override;
+    const char *getName() const override { return "Battery"; }
+    int targetFps() const override { return 5; }
 
 private:
     BatteryMonitor *m_monitor;
@@ -0,0 +1,257 @@
+#include "view_benchmark.h"
+#include "../display_manager.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+static const char *TAG = "ViewBenchmark";
+
+// Durée de chaque test : sous le budget d'une frame de vue statique (FrameWatchdog)
+#define TEST_DURATION_US 100000
+// Primitives enchaînées entre deux lectures de l'horloge
+#define OPS_PER_BATCH 16
+// Les tests commencent après la transition d'entrée
+#define START_DELAY_US 400000
+#define ROW_HEIGHT 18
+#define TABLE_TOP 58
+
+const ViewBenchmark::Case ViewBenchmark::s_cases[CASE_COUNT] = {
+    {"fillRect 8", FillRect, 8, 8, nullptr},
+    {"fillRect 32", FillRect, 32, 32, nullptr},
+    {"fillRect 120", FillRect, 120, 120, nullptr},
+    {"fillRect full", FillRect, 240, 320, nullptr},
+    {"drawLine", DrawLine, 100, 60, nullptr},
+    {"fillCircle", FillCircle, 20, 20, nullptr},
+    {"fillEllipse", FillEllipse, 30, 15, nullptr},
+    {"fillTriangle", FillTriangle, 60, 60, nullptr},
+    {"text Orbitron", DrawString, 0, 0, &Orbitron_Bold24pt7b},
+    {"text Font2", DrawString, 0, 0, &fonts::Font2},
+    {"text Font4", DrawString, 0, 0, &fonts::Font4},
+    {"drawPixel", DrawPixel, 1, 1, nullptr},
+    {"pushSprite", PushSprite, 0, 0, nullptr},
+};
+
+static const char *BENCH_TEXT = "BADGE 42";
+
+ViewBenchmark::ViewBenchmark(LGFX &lcd, DisplayManager &displayManager)
+    : View(false), m_lcd(lcd), m_displayManager(displayManager)
+{
+}
+
+void ViewBenchmark::onEnterView()
+{
+    m_next = 0;
+    m_startUs = esp_timer_get_time() + START_DELAY_US;
+}
+
+void ViewBenchmark::render(LGFX &display, LGFX_Sprite &spr)
+{
+    if (m_next < CASE_COUNT && esp_timer_get_time() >= m_startUs)
+    {
+        runCase(spr, m_next);
+        m_next++;
+        if (m_next == CASE_COUNT)
+        {
+#ifdef CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ
+            ESP_LOGI(TAG, "Benchmark done (CPU %d MHz)", CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ);
+#else
+            ESP_LOGI(TAG, "Benchmark done");
+#endif
+        }
+    }
+
+    // Le tableau recouvre ce que le test a dessiné
+    renderResults(spr);
+    if (m_next < CASE_COUNT)
+        requestRedraw();
+}
+
+// Pixels couverts par une primitive, pour le débit en MPixel/s
+uint32_t ViewBenchmark::pixelsPerOp(LGFX_Sprite &spr, const Case &test)
+{
+    switch (test.primitive)
+    {
+    case FillRect:
+        return test.w * test.h;
+    case DrawLine:
+        return std::max(test.w, test.h) + 1;
+    case FillCircle:
+    case FillEllipse:
+        return (uint32_t)(M_PI * test.w * test.h);
+    case FillTriangle:
+        return test.w * test.h / 2;
+    case DrawString:
+        spr.setFont(test.font);
+        return spr.textWidth(BENCH_TEXT) * spr.fontHeight();
+    case DrawPixel:
+        return 1;
+    case PushSprite:
+        return spr.width() * spr.height();
+    }
+    return 0;
+}
+
+// Une primitive ; i fait varier position et couleur pour ne pas mesurer toujours le même cas
+void ViewBenchmark::runOp(LGFX_Sprite &spr, const Case &test, uint32_t i)
+{
+    const int width = spr.width();
+    const int height = spr.height();
+    uint16_t color = (uint16_t)(i * 2654435761u >> 16);
+    int x = (int)(i * 37 % (uint32_t)std::max(1, width - test.w));
+    int y = (int)(i * 53 % (uint32_t)std::max(1, height - test.h));
+
+    switch (test.primitive)
+    {
+    case FillRect:
+        spr.fillRect(x, y, test.w, test.h, color);
+        break;
+    case DrawLine:
+        spr.drawLine(x, y, x + test.w, y + test.h, color);
+        break;
+    case FillCircle:
+        spr.fillCircle(x + test.w, y + test.w, test.w, color);
+        break;
+    case FillEllipse:
+        spr.fillEllipse(x + test.w, y + test.h, test.w, test.h, color);
+        break;
+    case FillTriangle:
+        spr.fillTriangle(x, y + test.h, x + test.w / 2, y, x + test.w, y + test.h, color);
+        break;
+    case DrawString:
+        spr.setTextColor(color);
+        spr.drawString(BENCH_TEXT, (int)(i * 37 % (uint32_t)(width / 2)), (int)(i * 53 % (uint32_t)(height - 40)));
+        break;
+    case DrawPixel:
+        spr.drawPixel((int)(i * 37 % (uint32_t)width), (int)(i * 53 % (uint32_t)height), color);
+        break;
+    case PushSprite:
+        // Mesuré par runPushCase()
+        break;
+    }
+}
+
+// Envois plein écran par la tâche d'envoi (seule propriétaire du bus LCD), chronométrés par
+// DisplayManager. Retourne false si la vue n'est pas rendue dans le sprite plein écran.
+bool ViewBenchmark::runPushCase(LGFX_Sprite &spr, Result &result)
+{
+    uint32_t ops = 0;
+    int64_t elapsed = 0;
+    do
+    {
+        int64_t pushUs = m_displayManager.measureSpritePush(spr);
+        if (pushUs < 0)
+            return false;
+        elapsed += pushUs;
+        ops++;
+    } while (elapsed < TEST_DURATION_US);
+    result.ops = ops;
+    result.elapsedUs = elapsed;
+    return true;
+}
+
+void ViewBenchmark::runCase(LGFX_Sprite &spr, int index)
+{
+    const Case &test = s_cases[index];
+    Result &result = m_results[index];
+    result.pixelsPerOp = pixelsPerOp(spr, test);
+    result.skipped = false;
+    if (test.primitive == PushSprite)
+    {
+        if (!runPushCase(spr, result))
+        {
+            // Bandes de repli ou sprite réduit : pushSprite ne mesurerait rien de réel
+            result.skipped = true;
+            ESP_LOGW(TAG, "%-14s skipped: no full-frame sprite", test.name);
+            return;
+        }
+    }
+    else
+    {
+        spr.setTextDatum(textdatum_t::top_left);
+        spr.setTextSize(1);
+        uint32_t ops = 0;
+        int64_t start = esp_timer_get_time();
+        int64_t elapsed = 0;
+        do
+        {
+            for (uint32_t i = 0; i < OPS_PER_BATCH; i++)
+                runOp(spr, test, ops + i);
+            ops += OPS_PER_BATCH;
+            elapsed = esp_timer_get_time() - start;
+        } while (elapsed < TEST_DURATION_US);
+        spr.setFont(nullptr);
+        result.ops = ops;
+        result.elapsedUs = elapsed;
+    }
+
+    float opsPerSecond = result.ops * 1000000.0f / result.elapsedUs;
+    ESP_LOGI(TAG, "%-14s %9.0f ops/s %8.2f MPixel/s", test.name, opsPerSecond,
+             opsPerSecond * result.pixelsPerOp / 1000000.0f);
+}
+
+void ViewBenchmark::renderResults(LGFX_Sprite &spr)
+{
+    const uint16_t background = m_lcd.color565(5, 0, 15);
+    const uint16_t cyan = m_lcd.color565(0, 255, 255);
+    const uint16_t pink = m_lcd.color565(255, 20, 220);
+    const uint16_t white = m_lcd.color565(230, 230, 230);
+    const uint16_t grey = m_lcd.color565(110, 110, 130);
+    const int width = spr.width();
+
+    spr.fillScreen(background);
+    spr.setTextSize(1);
+    spr.setFont(&fonts::Font4);
+    spr.setTextDatum(textdatum_t::top_center);
+    spr.setTextColor(pink);
+    spr.drawString("BENCHMARK", width / 2, 8);
+
+    spr.setFont(&fonts::Font2);
+    spr.setTextColor(cyan);
+    spr.setTextDatum(textdatum_t::top_left);
+    spr.drawString("test", 6, TABLE_TOP - ROW_HEIGHT);
+    spr.setTextDatum(textdatum_t::top_right);
+    spr.drawString("ops/s", 168, TABLE_TOP - ROW_HEIGHT);
+    spr.drawString("MPix/s", width - 6, TABLE_TOP - ROW_HEIGHT);
+
+    char text[16];
+    for (int i = 0; i < CASE_COUNT; i++)
+    {
+        int y = TABLE_TOP + i * ROW_HEIGHT;
+        bool done = i < m_next;
+        spr.setTextColor(done ? white : grey);
+        spr.setTextDatum(textdatum_t::top_left);
+        spr.drawString(s_cases[i].name, 6, y);
+        spr.setTextDatum(textdatum_t::top_right);
+        if (!done)
+        {
+            spr.drawString(i == m_next ? "..." : "-", 168, y);
+            continue;
+        }
+
+        const Result &result = m_results[i];
+        if (result.skipped)
+        {
+            spr.drawString("n/a", 168, y);
+            spr.drawString("n/a", width - 6, y);
+            continue;
+        }
+        float opsPerSecond = result.ops * 1000000.0f / result.elapsedUs;
+        if (opsPerSecond >= 100000.0f)
+            snprintf(text, sizeof(text), "%.0fk", opsPerSecond / 1000.0f);
+        else
+            snprintf(text, sizeof(text), "%.1f", opsPerSecond);
+        spr.drawString(text, 168, y);
+        snprintf(text, sizeof(text), "%.2f", opsPerSecond * result.pixelsPerOp / 1000000.0f);
+        spr.drawString(text, width - 6, y);
+    }
+
+    spr.setTextDatum(textdatum_t::bottom_center);
+    spr.setTextColor(grey);
+#ifdef CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ
+    snprintf(text, sizeof(text), "CPU %d MHz", CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ);
+    spr.drawString(text, width / 2, spr.height() - 4);
+#endif
+    spr.setFont(nullptr);
+}
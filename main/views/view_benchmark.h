@@ -0,0 +1,70 @@
+class DisplayManager;
+
+#ifndef VIEW_BENCHMARK_H
+#define VIEW_BENCHMARK_H
+
+#include "view.h"
+#include "../lgfx_custom.h"
+
+// Microbenchmark des primitives LovyanGFX utilisées par les vues, sur la carte : chaque test
+// répète une primitive dans le sprite plein écran (ou l'envoi du sprite à l'écran, fait par la
+// tâche d'envoi de DisplayManager) pendant TEST_DURATION_US, un test par frame. Les résultats (ops/s, MPixel/s) sont affichés
+// et loggés, pour comparer builds et fréquences d'horloge. Relancé à chaque entrée dans la vue.
+class ViewBenchmark : public View
+{
+public:
+    ViewBenchmark(LGFX &lcd, DisplayManager &displayManager);
+    void render(LGFX &display, LGFX_Sprite &spr) override;
+    const char *getName() const override { return "Benchmark"; }
+    // Vue statique : chaque frame lance le test suivant et redemande un rendu
+    int targetFps() const override { return 0; }
+    bool usesSnapshotCache() const override { return false; }
+    void onEnterView() override;
+
+private:
+    enum Primitive
+    {
+        FillRect,
+        DrawLine,
+        FillCircle,
+        FillEllipse,
+        FillTriangle,
+        DrawString,
+        DrawPixel,
+        PushSprite
+    };
+
+    struct Case
+    {
+        const char *name;
+        Primitive primitive;
+        int w; // Dimensions de la primitive (rectangle, rayons, dx / dy de la ligne...)
+        int h;
+        const lgfx::IFont *font;
+    };
+
+    struct Result
+    {
+        uint32_t ops;
+        int64_t elapsedUs;
+        uint32_t pixelsPerOp;
+        bool skipped; // Test sans objet dans ce mode de rendu (affiché "n/a")
+    };
+
+    static const int CASE_COUNT = 13;
+    static const Case s_cases[CASE_COUNT];
+
+    void runCase(LGFX_Sprite &spr, int index);
+    void runOp(LGFX_Sprite &spr, const Case &test, uint32_t i);
+    bool runPushCase(LGFX_Sprite &spr, Result &result);
+    uint32_t pixelsPerOp(LGFX_Sprite &spr, const Case &test);
+    void renderResults(LGFX_Sprite &spr);
+
+    LGFX &m_lcd;
+    DisplayManager &m_displayManager;
+    Result m_results[CASE_COUNT];
+    int m_next = 0;
+    int64_t m_startUs = 0;
+};
+
+#endif // VIEW_BENCHMARK_H
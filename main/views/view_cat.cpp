@@ -1,4 +1,5 @@
 #include "view_cat.h"
+#include "../span_tracer.h"
 #include "button.h"
 #include "esp_timer.h"
 #include "esp_random.h"
@@ -62,6 +63,11 @@ void ViewCat::init()
 
 void ViewCat::update(float dt)
 {
+    if (!m_initialized)
+    {
+        init();
+    }
+
     m_animation_timer += dt;
     
     // Gestion du clignement des yeux (quand réveillé)
@@ -220,6 +226,28 @@ bool ViewCat::handleTouch(int x, int y)
         return false;
     }
 
+    return updatePetting(x, y, m_state.dt);
+}
+
+bool ViewCat::handleTouchEvent(const TouchEvent &event)
+{
+    // La durée de caresse suit le temps réel entre échantillons, pas la cadence de rendu
+    switch (event.type)
+    {
+    case TouchEvent::Hold:
+    case TouchEvent::Drag:
+        return updatePetting(event.x, event.y, event.dtUs * 0.000001f);
+    case TouchEvent::Up:
+        handleTouch(-1, -1);
+        return false;
+    default:
+        return false;
+    }
+}
+
+// Caresse à la position (x, y) pendant dt secondes ; retourne true si le chat est touché
+bool ViewCat::updatePetting(int x, int y, float dt)
+{
     // Vérifier si on touche le chat (zone centrale, réduite pour laisser place aux bords)
     float dx = x - m_cat_x;
     float dy = y - m_cat_y;
@@ -253,7 +281,7 @@ bool ViewCat::handleTouch(int x, int y)
         }
         
         // Accumuler la durée tant qu'on touche le chat (même sans mouvement)
-        m_pet_duration += m_state.dt;
+        m_pet_duration += dt;
         m_calm_timer = 0.0f;
         
         m_last_touch_x = x;
@@ -277,13 +305,6 @@ bool ViewCat::handleTouch(int x, int y)
 
 void ViewCat::render(LGFX &display, LGFX_Sprite &spr)
 {
-    if (!m_initialized)
-    {
-        init();
-    }
-
-    update(m_state.dt);
-
     renderBackground(spr);
     
     if (m_cat_state == LION)
@@ -329,6 +350,7 @@ void ViewCat::render(LGFX &display, LGFX_Sprite &spr)
 
 void ViewCat::renderBackground(LGFX_Sprite &spr)
 {
+    TRACE_SCOPE("Cat::renderBackground");
     spr.fillScreen(m_colBackground);
     
     // Ajouter quelques étoiles pour l'ambiance nuit
@@ -347,6 +369,7 @@ void ViewCat::renderBackground(LGFX_Sprite &spr)
 
 void ViewCat::renderSleepingZs(LGFX_Sprite &spr)
 {
+    TRACE_SCOPE("Cat::renderSleepingZs");
     for (int i = 0; i < MAX_ZS; i++)
     {
         if (!m_zs[i].active)
@@ -369,6 +392,7 @@ void ViewCat::renderSleepingZs(LGFX_Sprite &spr)
 
 void ViewCat::renderCat(LGFX_Sprite &spr)
 {
+    TRACE_SCOPE("Cat::renderCat");
     int x = m_cat_x;
     int y = m_cat_y;
     
@@ -476,6 +500,7 @@ void ViewCat::renderCat(LGFX_Sprite &spr)
 
 void ViewCat::renderLion(LGFX_Sprite &spr)
 {
+    TRACE_SCOPE("Cat::renderLion");
     int x = m_cat_x;
     int y = m_cat_y;
     
@@ -506,7 +531,8 @@ void ViewCat::renderLion(LGFX_Sprite &spr)
     
     // Crinière réaliste - autour de la tête avec emphase sur le haut et les côtés
     // Couches de crinière pour effet de profondeur
-    int criniere_layers = 3;
+    // Couche externe omise en qualité minimale
+    int criniere_layers = m_state.quality > 0 ? 3 : 2;
     
     for (int layer = criniere_layers - 1; layer >= 0; layer--)
     {
@@ -622,7 +648,7 @@ void ViewCat::renderLion(LGFX_Sprite &spr)
                 spr.fillTriangle(tip_x, tip_y, base_x1, base_y1, base_x2, base_y2, mane_color);
                 
                 // Contours sombres pour créer de la profondeur (surtout sur le haut)
-                if (layer > 0 && (i % 5 == 0 || (is_top && i % 3 == 0)))
+                if (m_state.quality >= 2 && layer > 0 && (i % 5 == 0 || (is_top && i % 3 == 0)))
                 {
                     spr.drawTriangle(tip_x, tip_y, base_x1, base_y1, base_x2, base_y2, m_lcd.color565(120, 60, 8));
                 }
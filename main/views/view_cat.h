@@ -22,6 +22,10 @@ public:
     ViewCat(AppState &state, LGFX &lcd);
     void render(LGFX &display, LGFX_Sprite &spr) override;
     bool handleTouch(int x, int y) override;
+    bool handleTouchEvent(const TouchEvent &event) override;
+    const char *getName() const override { return "Cat"; }
+    int targetFps() const override { return 30; }
+    bool supportsSplitRender() const override { return true; }
     bool isInteractiveView() const override { return true; }
     bool isTouchInInteractiveZone(int x, int y) const override
     {
@@ -33,7 +37,7 @@ public:
     }
 
     void init();
-    void update(float dt);
+    void update(float dt) override;
 
     void renderBackground(LGFX_Sprite &spr);
     void renderCat(LGFX_Sprite &spr);
@@ -41,6 +45,7 @@ public:
     void renderLion(LGFX_Sprite &spr);
 
     void spawnZ();
+    bool updatePetting(int x, int y, float dt);
 
 private:
     AppState &m_state;
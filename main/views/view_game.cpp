@@ -1,9 +1,11 @@
 #include "view_game.h"
+#include "../span_tracer.h"
 #include "button.h"
 #include "esp_timer.h"
 #include "esp_random.h"
 #include "esp_log.h"
 #include "config.h"
+#include <algorithm>
 #include <cmath>
 
 static const char *TAG = "ViewGame";
@@ -48,8 +50,8 @@ void ViewGame::init()
     m_score = 0;
     m_game_time = 0.0f;
     m_spawn_interval = 1000; // Ajusté pour difficulté équilibrée
-    m_last_spawn = esp_timer_get_time() / 1000ULL;
-    m_last_update = m_last_spawn;
+    m_last_spawn = 0;
+    m_last_update = esp_timer_get_time() / 1000ULL;
 
     // Initialiser les cultures (disposition en grille 2x3, mieux centrée et regroupée)
     int crop_spacing_x = 55; // Espacement horizontal réduit
@@ -93,6 +95,15 @@ void ViewGame::init()
 
 void ViewGame::update(float dt)
 {
+    if (!m_initialized)
+    {
+        init();
+    }
+
+    // Pas de simulation tant que l'écran d'intro est affiché
+    if (m_show_intro)
+        return;
+
     if (m_game_over)
     {
         // Ne rien faire pendant le game over
@@ -102,7 +113,21 @@ void ViewGame::update(float dt)
     unsigned long now = esp_timer_get_time() / 1000ULL;
     m_last_update = now;
 
+    // Positions de départ du pas, entre lesquelles render() interpole
+    for (int i = 0; i < MAX_THREATS; i++)
+    {
+        m_threats[i].prev_x = m_threats[i].x;
+        m_threats[i].prev_y = m_threats[i].y;
+    }
+    for (int i = 0; i < MAX_PARTICLES; i++)
+    {
+        m_particles[i].prev_x = m_particles[i].x;
+        m_particles[i].prev_y = m_particles[i].y;
+    }
+
     m_game_time += dt;
+    // Apparitions cadencées sur le temps de jeu simulé, pas sur l'horloge
+    unsigned long game_ms = (unsigned long)(m_game_time * 1000.0f);
 
     // Augmenter la difficulté avec le temps
     if (m_spawn_interval > 200)
@@ -113,10 +138,10 @@ void ViewGame::update(float dt)
     }
 
     // Spawn des menaces
-    if (now - m_last_spawn > m_spawn_interval)
+    if (game_ms - m_last_spawn > m_spawn_interval)
     {
         spawnThreat();
-        m_last_spawn = now;
+        m_last_spawn = game_ms;
     }
 
     // Mettre à jour les cultures
@@ -282,7 +307,7 @@ void ViewGame::spawnThreat()
         // Type de menace aléatoire
         m_threats[slot].type = esp_random() % 3;
         m_threats[slot].active = true;
-        m_threats[slot].spawn_time = esp_timer_get_time() / 1000ULL;
+        m_threats[slot].spawn_time = m_game_time;
         m_threats[slot].phase = (esp_random() % 100) / 100.0f * 6.28f;
 
         // Pattern de mouvement aléatoire (plus de variété après 10s)
@@ -368,9 +393,17 @@ void ViewGame::spawnThreat()
         }
 
         m_threats[slot].size = 14 + (esp_random() % 6);
+        m_threats[slot].prev_x = m_threats[slot].x;
+        m_threats[slot].prev_y = m_threats[slot].y;
     }
 }
 
+// Position entre le pas précédent et le dernier, d'après la fraction de pas écoulée
+float ViewGame::interpolate(float prev, float current) const
+{
+    return prev + (current - prev) * interpolation();
+}
+
 void ViewGame::checkCollisions()
 {
     // Collision menaces <-> cultures
@@ -526,6 +559,8 @@ void ViewGame::createExplosion(float x, float y, uint16_t color)
 
         m_particles[i].x = x;
         m_particles[i].y = y;
+        m_particles[i].prev_x = x;
+        m_particles[i].prev_y = y;
         m_particles[i].vx = cos(angle) * speed;
         m_particles[i].vy = sin(angle) * speed;
         m_particles[i].life = 0.5f + (esp_random() % 100) / 200.0f;
@@ -538,11 +573,6 @@ void ViewGame::createExplosion(float x, float y, uint16_t color)
 
 void ViewGame::render(LGFX &display, LGFX_Sprite &spr)
 {
-    if (!m_initialized)
-    {
-        init();
-    }
-
     // Afficher l'écran d'intro si le jeu n'a pas démarré
     if (m_show_intro)
     {
@@ -550,9 +580,6 @@ void ViewGame::render(LGFX &display, LGFX_Sprite &spr)
         return;
     }
 
-    // Utiliser le delta time calculé globalement par DisplayManager
-    update(m_state.dt);
-
     renderBackground(spr);
     renderCrops(spr);
     renderThreats(spr);
@@ -567,6 +594,7 @@ void ViewGame::render(LGFX &display, LGFX_Sprite &spr)
 
 void ViewGame::renderBackground(LGFX_Sprite &spr)
 {
+    TRACE_SCOPE("Game::renderBackground");
     spr.fillScreen(m_colBackground);
 
     // Grille cyber en arrière-plan
@@ -582,6 +610,7 @@ void ViewGame::renderBackground(LGFX_Sprite &spr)
 
 void ViewGame::renderCrops(LGFX_Sprite &spr)
 {
+    TRACE_SCOPE("Game::renderCrops");
     for (int i = 0; i < MAX_CROPS; i++)
     {
         if (m_crops[i].health <= 0)
@@ -640,15 +669,18 @@ void ViewGame::renderCrops(LGFX_Sprite &spr)
 
 void ViewGame::renderThreats(LGFX_Sprite &spr)
 {
-    unsigned long now = esp_timer_get_time() / 1000ULL;
+    TRACE_SCOPE("Game::renderThreats");
+    // Temps de jeu de l'état dessiné (entre les deux derniers pas) : le même pour toutes les
+    // bandes de la frame, une menace à cheval sur deux bandes garde sa taille
+    float renderTime = m_game_time + (interpolation() - 1.0f) / updateRate();
 
     for (int i = 0; i < MAX_THREATS; i++)
     {
         if (!m_threats[i].active)
             continue;
 
-        int x = (int)m_threats[i].x;
-        int y = (int)m_threats[i].y;
+        int x = (int)interpolate(m_threats[i].prev_x, m_threats[i].x);
+        int y = (int)interpolate(m_threats[i].prev_y, m_threats[i].y);
 
         // Ne pas dessiner si au-dessus du header (y < 45)
         if (y < 45)
@@ -657,7 +689,7 @@ void ViewGame::renderThreats(LGFX_Sprite &spr)
         int size = 16; // Taille augmentée pour meilleure visibilité
 
         // Animation de pulsation légère
-        float age = (now - m_threats[i].spawn_time) / 1000.0f;
+        float age = std::max(0.0f, renderTime - m_threats[i].spawn_time);
         float pulse = sin(age * 8.0f) * 0.15f + 1.0f;
         size = (int)(size * pulse);
 
@@ -695,13 +727,14 @@ void ViewGame::renderThreats(LGFX_Sprite &spr)
 
 void ViewGame::renderParticles(LGFX_Sprite &spr)
 {
+    TRACE_SCOPE("Game::renderParticles");
     for (int i = 0; i < MAX_PARTICLES; i++)
     {
         if (!m_particles[i].active)
             continue;
 
-        int x = (int)m_particles[i].x;
-        int y = (int)m_particles[i].y;
+        int x = (int)interpolate(m_particles[i].prev_x, m_particles[i].x);
+        int y = (int)interpolate(m_particles[i].prev_y, m_particles[i].y);
 
         // Dessiner la particule (petit carré ou cercle)
         spr.fillCircle(x, y, 2, m_particles[i].color);
@@ -710,6 +743,7 @@ void ViewGame::renderParticles(LGFX_Sprite &spr)
 
 void ViewGame::renderHUD(LGFX_Sprite &spr)
 {
+    TRACE_SCOPE("Game::renderHUD");
     // Titre du jeu (à gauche)
     spr.setTextColor(m_colCyan);
     spr.setTextSize(1);
@@ -748,6 +782,7 @@ void ViewGame::renderHUD(LGFX_Sprite &spr)
 
 void ViewGame::renderGameOver(LGFX_Sprite &spr)
 {
+    TRACE_SCOPE("Game::renderGameOver");
     // Fond semi-transparent stable (sans pixels aléatoires qui clignotent)
     int box_x1 = 10;
     int box_y1 = 60;
@@ -829,6 +864,7 @@ void ViewGame::renderGameOver(LGFX_Sprite &spr)
 
 void ViewGame::renderIntro(LGFX_Sprite &spr)
 {
+    TRACE_SCOPE("Game::renderIntro");
     // Fond uni
     spr.fillScreen(m_colBackground);
 
@@ -22,12 +22,14 @@ struct Threat
 {
     float x;
     float y;
+    float prev_x; // Position au pas de simulation précédent (interpolation du rendu)
+    float prev_y;
     float vx;
     float vy;
     bool active;
     uint8_t type; // 0=insecte, 1=nuage orage, 2=grêle
     float size;
-    unsigned long spawn_time;
+    float spawn_time; // Temps de jeu (s) à l'apparition, base de la pulsation
     uint8_t movement_pattern; // 0=direct, 1=sinusoidal, 2=circular
     float phase;              // Phase pour les mouvements sinusoïdaux
     float target_x;           // Cible X pour trajectoire intelligente
@@ -39,6 +41,8 @@ struct GameParticle
 {
     float x;
     float y;
+    float prev_x;
+    float prev_y;
     float vx;
     float vy;
     float life;
@@ -52,9 +56,15 @@ public:
     ViewGame(AppState &state, LGFX &lcd);
     void render(LGFX &display, LGFX_Sprite &spr) override;
     bool handleTouch(int x, int y) override;
+    const char *getName() const override { return "Game"; }
+    int targetFps() const override { return 60; }
+    // Simulation à pas fixe : difficulté et vitesses indépendantes des FPS atteints
+    int updateRate() const override { return 60; }
+
+    RenderMode renderMode() const override { return RenderMode::Banded; }
 
     void init();
-    void update(float dt);
+    void update(float dt) override;
     void handleTouchInternal(int touch_x, int touch_y);
 
     void renderBackground(LGFX_Sprite &spr);
@@ -68,6 +78,7 @@ public:
     void spawnThreat();
     void checkCollisions();
     void createExplosion(float x, float y, uint16_t color);
+    float interpolate(float prev, float current) const;
 
 private:
     AppState &m_state;
@@ -81,7 +92,7 @@ private:
     bool m_victory = false;
     int m_score = 0;
     int32_t m_best_score = 0;
-    unsigned long m_last_spawn = 0;
+    unsigned long m_last_spawn = 0;        // ms de temps de jeu (m_game_time)
     unsigned long m_spawn_interval = 2000; // ms entre spawn
     float m_game_time = 0.0f;
     unsigned long m_last_update = 0;
@@ -1,8 +1,15 @@
 #include "view_plasma.h"
+#include "../span_tracer.h"
 #include "user_info.h"
 #include "esp_timer.h"
+#include <algorithm>
 #include "../Orbitron_Bold24pt7b.h"
 
+// Prénom : taille de la police Orbitron, position (haut du texte) et décalage de l'ombre
+#define NAME_TEXT_SIZE 0.8f
+#define NAME_Y 20
+#define NAME_SHADOW 2
+
 // Lookup table pour FastSin: 128 entrées, valeurs de 0 à 255
 // Représente une demi-période de sinusoïde (0 à π)
 static const uint8_t sin_lookup[128] = {
@@ -116,17 +123,30 @@ void ViewPlasma::updateAnimation(float dt)
 
 void ViewPlasma::renderPlasma(LGFX_Sprite &spr)
 {
-    // Accéder aux dimensions depuis l'état
+    TRACE_SCOPE("Plasma::renderPlasma");
+    // Accéder aux dimensions depuis l'état : le plasma est calculé en coordonnées écran,
+    // le sprite peut être en résolution réduite (scale = 2 en demi-résolution)
     const int width = m_state.screenW;
     const int height = m_state.screenH;
     const int cx = width >> 1;
     const int cy = height >> 1;
+    const int scale = std::max(1, width / (int)spr.width());
+
+    // Cellules de 4 pixels, 8 quand la qualité baisse (4 fois moins de calculs)
+    const int cell = m_state.quality >= 2 ? 4 : 8;
+    const int cellSize = cell / scale;
+
+    // Ne calculer que les lignes visibles dans le clip (une seule bande en mode Banded)
+    int32_t clipX, clipY, clipW, clipH;
+    spr.getClipRect(&clipX, &clipY, &clipW, &clipH);
+    const int yStart = (clipY * scale) & ~(cell - 1);
+    const int yEnd = std::min(height, (int)(clipY + clipH) * scale);
 
     spr.startWrite(); // Commencer l'écriture pour de meilleures performances
 
-    for (int y = 0; y < height; y += 4)
+    for (int y = yStart; y < yEnd; y += cell)
     {
-        for (int x = 0; x < width; x += 4)
+        for (int x = 0; x < width; x += cell)
         {
             // Calcul des distances au centre
             long dx = x - cx;
@@ -156,29 +176,30 @@ void ViewPlasma::renderPlasma(LGFX_Sprite &spr)
             uint16_t color = r >> 4 << 12 | g >> 3 << 6 | b >> 4 << 1;
 
             // Dessiner le pixel
-            spr.fillRect(x, y, 4, 4, color);
+            spr.fillRect(x / scale, y / scale, cellSize, cellSize, color);
         }
     }
 
     spr.endWrite(); // Terminer l'écriture
 }
 
-void ViewPlasma::renderName(LGFX_Sprite &spr)
+void ViewPlasma::renderName(LGFX_Sprite &spr) const
 {
+    TRACE_SCOPE("Plasma::renderName");
     // Afficher le prénom en haut de l'écran avec effet néon
     spr.setTextDatum(TC_DATUM);
     spr.setFont(&Orbitron_Bold24pt7b);
-    spr.setTextSize(0.8);
+    spr.setTextSize(NAME_TEXT_SIZE);
 
     uint16_t blackColor = m_lcd.color565(255, 0, 150);
     uint16_t shadowColor = m_lcd.color565(0, 0, 0);
 
     int centerX = m_state.screenW / 2;
-    int y = 20;
+    int y = NAME_Y;
 
     // Effet néon simple : ombre décalée
     spr.setTextColor(shadowColor);
-    spr.drawString(user_info.prenom.c_str(), centerX + 2, y + 2);
+    spr.drawString(user_info.prenom.c_str(), centerX + NAME_SHADOW, y + NAME_SHADOW);
 
     // Texte principal
     spr.setTextColor(blackColor);
@@ -189,16 +210,26 @@ void ViewPlasma::renderName(LGFX_Sprite &spr)
 
 void ViewPlasma::render(LGFX &display, LGFX_Sprite &spr)
 {
-    // Utiliser le delta time calculé globalement
-    float dt = m_state.dt;
-
-    // Mise à jour de l'animation
-    updateAnimation(dt);
-
     // Rendu du plasma
     renderPlasma(spr);
 
-    // Afficher le prénom au-dessus du plasma
+    // Afficher le prénom au-dessus du plasma ; en demi-résolution il est dessiné par
+    // renderOverlay() sur les bandes agrandies, pour ne pas perdre la finesse du texte
+    if (spr.width() == m_state.screenW)
+        renderName(spr);
+}
+
+void ViewPlasma::renderOverlay(LGFX_Sprite &spr) const
+{
+    // Seules les premières bandes croisent le prénom
+    int32_t clipX, clipY, clipW, clipH;
+    spr.getClipRect(&clipX, &clipY, &clipW, &clipH);
+    spr.setFont(&Orbitron_Bold24pt7b);
+    spr.setTextSize(NAME_TEXT_SIZE);
+    int bottom = NAME_Y + NAME_SHADOW + spr.fontHeight();
+    spr.setFont(nullptr);
+    if (clipY >= bottom || clipY + clipH <= NAME_Y)
+        return;
     renderName(spr);
 }
 
@@ -10,11 +10,20 @@ class ViewPlasma : public View
 public:
     ViewPlasma(AppState &state, LGFX &lcd);
     void render(LGFX &display, LGFX_Sprite &spr) override;
+    void update(float dt) override { updateAnimation(dt); }
+    // Rendu en demi-résolution (cellules de 4 pixels : aucune perte) ; par bandes si le petit sprite manque
+    RenderMode renderMode() const override { return RenderMode::Banded; }
+    int renderScale() const override { return 2; }
+    // Le prénom reste à pleine résolution par-dessus le plasma agrandi
+    void renderOverlay(LGFX_Sprite &spr) const override;
+    bool supportsSplitRender() const override { return true; }
     bool handleTouch(int x, int y) override;
+    const char *getName() const override { return "Plasma"; }
+    int targetFps() const override { return 60; }
 
     void updateAnimation(float dt);
     void renderPlasma(LGFX_Sprite &spr);
-    void renderName(LGFX_Sprite &spr);
+    void renderName(LGFX_Sprite &spr) const;
 
 private:
     AppState &m_state;
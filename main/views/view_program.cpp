@@ -1,81 +1,75 @@
 #include "view_program.h"
 #include <cstring>
 
-// Couleurs
-static uint16_t colBackground = 0;
-static uint16_t colCyan = 0;
-static uint16_t colYellow = 0;
-static uint16_t colPink = 0;
-static uint16_t colMint = 0;
-static uint16_t colOrange = 0;
-static uint16_t colTimeline = 0;
-
-static void initColors(LGFX &display)
-{
-    if (colBackground == 0)
-    {
-        colBackground = display.color565(5, 0, 15);
-        colCyan = display.color565(0, 255, 255);       // Cyan néon
-        colYellow = display.color565(255, 255, 0);     // Jaune vif
-        colPink = display.color565(255, 20, 220);      // Rose néon
-        colMint = display.color565(150, 255, 200);     // Vert menthe
-        colOrange = display.color565(255, 165, 0);     // Orange vif
-        colTimeline = display.color565(100, 150, 200); // Bleu pour timeline
-    }
-}
+// Couleurs (palette du sprite 4 bits, dans l'ordre de ViewProgram::Color)
+static const uint16_t s_palette[ViewProgram::COLOR_COUNT] = {
+    lgfx::color565(5, 0, 15),      // Fond
+    lgfx::color565(0, 255, 255),   // Cyan néon
+    lgfx::color565(255, 255, 0),   // Jaune vif
+    lgfx::color565(255, 20, 220),  // Rose néon
+    lgfx::color565(150, 255, 200), // Vert menthe
+    lgfx::color565(255, 165, 0),   // Orange vif
+    lgfx::color565(100, 150, 200), // Bleu pour timeline
+    lgfx::color565(255, 150, 230), // Rose clair du titre
+};
 
 ViewProgram::ViewProgram(AppState &state, LGFX &lcd)
     : View(false), m_state(state), m_lcd(lcd)
 {
-    initColors(lcd);
 }
 
-void ViewProgram::renderProgramItem(LGFX_Sprite &spr, const char *time, const char *title, int y, uint16_t color, bool isLast)
+const uint16_t *ViewProgram::palette(int &count) const
+{
+    count = COLOR_COUNT;
+    return s_palette;
+}
+
+void ViewProgram::renderProgramItem(LGFX_Sprite &spr, const char *time, const char *title, int y, Color color, bool isLast)
 {
     // Timeline verticale
     if (!isLast)
     {
-        spr.drawLine(28, y + 10, 28, y + 38, colTimeline);
+        spr.drawLine(28, y + 10, 28, y + 38, paletteColor(spr, colTimeline));
     }
 
     // Marqueur coloré selon le type d'événement
-    spr.fillRect(26, y + 8, 5, 5, color);
-    spr.drawRect(25, y + 7, 7, 7, color);
+    spr.fillRect(26, y + 8, 5, 5, paletteColor(spr, color));
+    spr.drawRect(25, y + 7, 7, 7, paletteColor(spr, color));
 
     // Heure à gauche en cyan néon
     spr.setTextDatum(textdatum_t::middle_left);
-    spr.setTextColor(colCyan);
+    spr.setTextColor(paletteColor(spr, colCyan));
     spr.setFont(&fonts::Font2);
     spr.drawString(time, 38, y + 10);
 
     // Titre à droite de l'horaire avec la couleur de catégorie
     spr.setTextDatum(textdatum_t::middle_left);
-    spr.setTextColor(color);
+    spr.setTextColor(paletteColor(spr, color));
     spr.setFont(&fonts::Font2);
     spr.drawString(title, 90, y + 10);
 }
 
 void ViewProgram::render(LGFX &display, LGFX_Sprite &spr)
 {
-    spr.fillScreen(colBackground);
+    spr.fillScreen(paletteColor(spr, colBackground));
 
     // Bordures décoratives retrofuturiste
-    spr.drawRect(2, 2, spr.width() - 4, spr.height() - 4, colCyan);
-    spr.drawRect(3, 3, spr.width() - 6, spr.height() - 6, colPink);
+    spr.drawRect(2, 2, spr.width() - 4, spr.height() - 4, paletteColor(spr, colCyan));
+    spr.drawRect(3, 3, spr.width() - 6, spr.height() - 6, paletteColor(spr, colPink));
 
     // Titre centré avec effet néon
     spr.setTextSize(1);
     spr.setTextDatum(textdatum_t::top_center);
     spr.setFont(&fonts::Font4);
-    spr.setTextColor(colPink);
+    spr.setTextColor(paletteColor(spr, colPink));
     spr.drawString("PROGRAMME", spr.width() / 2, 12);
-    spr.setTextColor(spr.color565(255, 150, 230));
+    spr.setTextColor(paletteColor(spr, colLightPink));
     spr.drawString("PROGRAMME", spr.width() / 2 + 1, 13);
 
     // Ligne séparatrice néon
     for (int i = 0; i < 3; i++)
     {
-        spr.drawFastHLine(15, 40 + i, spr.width() - 30, colCyan);
+        spr.drawFastHLine(15, 40 + i, spr.width() - 30, paletteColor(spr, colCyan));
     }
 
     int y = 53;
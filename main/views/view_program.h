@@ -8,14 +8,34 @@
 class ViewProgram : public View
 {
 public:
+    // Index des couleurs dans la palette de la vue
+    enum Color
+    {
+        colBackground,
+        colCyan,
+        colYellow,
+        colPink,
+        colMint,
+        colOrange,
+        colTimeline,
+        colLightPink,
+        COLOR_COUNT
+    };
+
     ViewProgram(AppState &state, LGFX &lcd);
     void render(LGFX &display, LGFX_Sprite &spr) override;
+    const char *getName() const override { return "Program"; }
+    // Vue statique : rien ne change après le premier rendu (envoyé en entier par DisplayManager)
+    bool reportsDamage() const override { return true; }
+    // 8 couleurs : sprite à palette de 4 bits (37,5 Ko au lieu de 150 Ko)
+    int colorDepth() const override { return 4; }
+    const uint16_t *palette(int &count) const override;
 
 private:
     AppState &m_state;
     LGFX &m_lcd;
 
-    void renderProgramItem(LGFX_Sprite &spr, const char *time, const char *title, int y, uint16_t color, bool isLast = false);
+    void renderProgramItem(LGFX_Sprite &spr, const char *time, const char *title, int y, Color color, bool isLast = false);
 };
 
 #endif // VIEW_PROGRAM_H
@@ -3,16 +3,33 @@
 #include "user_info.h"
 #include "qrcodegen.h"
 
+// Palette rétro-futuriste (Synthwave/Cyberpunk), dans l'ordre de ViewQRCode::Color
+static const uint16_t s_palette[ViewQRCode::COLOR_COUNT] = {
+    lgfx::color565(5, 0, 20),     // Bleu-violet très foncé
+    lgfx::color565(15, 0, 35),    // Violet profond plus riche
+    lgfx::color565(0, 255, 255),  // Cyan néon
+    lgfx::color565(255, 0, 150),  // Magenta néon
+    lgfx::color565(180, 0, 255),  // Violet néon
+    lgfx::color565(255, 255, 0),  // Jaune néon
+    lgfx::color565(255, 255, 255) // Blanc (fond du QR code, nom)
+};
+
+const uint16_t *ViewQRCode::palette(int &count) const
+{
+    count = COLOR_COUNT;
+    return s_palette;
+}
+
 // Affiche le QR code généré dans le buffer global g_qrcode
 void ViewQRCode::render(LGFX &display, LGFX_Sprite &spr)
 {
-    // Palette rétro-futuriste (Synthwave/Cyberpunk)
-    uint16_t bg_dark_alt = spr.color565(5, 0, 20);     // Bleu-violet très foncé
-    uint16_t bg_dark = spr.color565(15, 0, 35);        // Violet profond plus riche
-    uint16_t neon_cyan = spr.color565(0, 255, 255);    // Cyan néon
-    uint16_t neon_magenta = spr.color565(255, 0, 150); // Magenta néon
-    uint16_t neon_purple = spr.color565(180, 0, 255);  // Violet néon
-    uint16_t neon_yellow = spr.color565(255, 255, 0);  // Jaune néon
+    uint16_t bg_dark_alt = paletteColor(spr, colBackgroundAlt);
+    uint16_t bg_dark = paletteColor(spr, colBackground);
+    uint16_t neon_cyan = paletteColor(spr, colCyan);
+    uint16_t neon_magenta = paletteColor(spr, colMagenta);
+    uint16_t neon_purple = paletteColor(spr, colPurple);
+    uint16_t neon_yellow = paletteColor(spr, colYellow);
+    uint16_t white = paletteColor(spr, colWhite);
 
     // Fond rétro-futuriste (violet foncé)
     spr.fillRect(0, 0, spr.width(), spr.height(), bg_dark);
@@ -55,7 +72,7 @@ void ViewQRCode::render(LGFX &display, LGFX_Sprite &spr)
     spr.drawRect(x0 - 9, y0 - 9, qr_pix_size + 18, qr_pix_size + 18, neon_cyan);
     spr.drawRect(x0 - 8, y0 - 8, qr_pix_size + 16, qr_pix_size + 16, neon_magenta);
 
-    spr.fillRect(x0 - 7, y0 - 7, qr_pix_size + 14, qr_pix_size + 14, TFT_WHITE);
+    spr.fillRect(x0 - 7, y0 - 7, qr_pix_size + 14, qr_pix_size + 14, white);
 
     // Affichage du QR code avec effet néon
     for (int y = 0; y < qr_size; y++)
@@ -94,7 +111,7 @@ void ViewQRCode::render(LGFX &display, LGFX_Sprite &spr)
 
     // Nom en majuscules style rétro
     spr.setTextSize(1);
-    spr.setTextColor(TFT_WHITE);
+    spr.setTextColor(white);
     std::string nom_complet = user_info.prenom + std::string(" ") + user_info.nom;
     for (auto &c : nom_complet)
         c = toupper(c);
@@ -7,8 +7,25 @@
 class ViewQRCode : public View
 {
 public:
+    // Index des couleurs dans la palette de la vue
+    enum Color
+    {
+        colBackgroundAlt,
+        colBackground,
+        colCyan,
+        colMagenta,
+        colPurple,
+        colYellow,
+        colWhite,
+        COLOR_COUNT
+    };
+
     ViewQRCode() : View(false) {}
     void render(LGFX &display, LGFX_Sprite &spr) override;
+    const char *getName() const override { return "QRCode"; }
+    // 7 couleurs : sprite à palette de 4 bits
+    int colorDepth() const override { return 4; }
+    const uint16_t *palette(int &count) const override;
 };
 
 #endif // VIEW_QRCODE_H
@@ -10,6 +10,12 @@ ViewSettings::ViewSettings(LGFX &lcd, DisplayManager &displayManager)
 {
     // Init badge colors if needed
     initColors(lcd);
+    // Palette du sprite 4 bits (couleurs rétro initialisées à l'exécution)
+    m_palette[palBackground] = colBackground;
+    m_palette[palCyan] = colCyan;
+    m_palette[palYellow] = colYellow;
+    m_palette[palPink] = colPink;
+    m_palette[palMagenta] = colMagenta;
 
     // Slider brightness
     m_sliderX = 20;
@@ -32,11 +38,17 @@ ViewSettings::ViewSettings(LGFX &lcd, DisplayManager &displayManager)
     this->m_stepperBtnH = 28;
 }
 
+const uint16_t *ViewSettings::palette(int &count) const
+{
+    count = COLOR_COUNT;
+    return m_palette;
+}
+
 // --- Slider générique ---
 void ViewSettings::drawSlider(LGFX_Sprite &spr, int x, int y, int w, int h, int colorFill, int colorGlow, int colorLabel, int colorValue, float value, float min, float max, const char *valueFormat, const char *label, int valueInt)
 {
     // Background
-    spr.fillRoundRect(x, y, w, h, 6, colBackground);
+    spr.fillRoundRect(x, y, w, h, 6, paletteColor(spr, palBackground));
     // Glow
     spr.drawRoundRect(x - 1, y - 1, w + 2, h + 2, 8, colorGlow);
     // Fill
@@ -44,7 +56,7 @@ void ViewSettings::drawSlider(LGFX_Sprite &spr, int x, int y, int w, int h, int
     spr.fillRoundRect(x + 4, y + 4, fillW, h - 8, 4, colorFill);
     // Knob
     int knobX = x + 4 + fillW;
-    spr.fillCircle(knobX, y + h / 2, h / 2 - 2, colYellow);
+    spr.fillCircle(knobX, y + h / 2, h / 2 - 2, paletteColor(spr, palYellow));
     // Value (small font)
     spr.setTextColor(colorValue);
     spr.setFont(&fonts::Font2);
@@ -66,19 +78,19 @@ void ViewSettings::drawSlider(LGFX_Sprite &spr, int x, int y, int w, int h, int
 
 void ViewSettings::render(LGFX &display, LGFX_Sprite &spr)
 {
-    spr.fillScreen(colBackground);
+    spr.fillScreen(paletteColor(spr, palBackground));
     // Title (no accent)
-    spr.setTextColor(colYellow);
+    spr.setTextColor(paletteColor(spr, palYellow));
     spr.setFont(&fonts::Font2);
     spr.setTextSize(1.3);
     spr.setTextDatum(textdatum_t::top_center);
     spr.drawString("Reglages", display.width() / 2, 8);
 
     // Slider luminosité active
-    drawSlider(spr, m_sliderX, m_sliderY, m_sliderW, m_sliderH, colCyan, colCyan, colPink, colCyan, (float)Config::activeBrightness, 0.0f, 100.0f, "%d%%", "Luminosite", (int)Config::activeBrightness);
+    drawSlider(spr, m_sliderX, m_sliderY, m_sliderW, m_sliderH, paletteColor(spr, palCyan), paletteColor(spr, palCyan), paletteColor(spr, palPink), paletteColor(spr, palCyan), (float)Config::activeBrightness, 0.0f, 100.0f, "%d%%", "Luminosite", (int)Config::activeBrightness);
 
     // Slider luminosité veille
-    drawSlider(spr, m_sliderSleepX, m_sliderSleepY, m_sliderSleepW, m_sliderSleepH, colMagenta, colMagenta, colPink, colMagenta, (float)Config::sleepBrightness, 0.0f, 100.0f, "%d%%", "Lum. veille", (int)Config::sleepBrightness);
+    drawSlider(spr, m_sliderSleepX, m_sliderSleepY, m_sliderSleepW, m_sliderSleepH, paletteColor(spr, palMagenta), paletteColor(spr, palMagenta), paletteColor(spr, palPink), paletteColor(spr, palMagenta), (float)Config::sleepBrightness, 0.0f, 100.0f, "%d%%", "Lum. veille", (int)Config::sleepBrightness);
 
     // Stepper veille auto
     int stepperX = this->m_stepperAwakeX;
@@ -88,28 +100,28 @@ void ViewSettings::render(LGFX &display, LGFX_Sprite &spr)
     int valueW = 55;
     int valueH = btnH;
     // Label
-    spr.setTextColor(colPink);
+    spr.setTextColor(paletteColor(spr, palPink));
     spr.setFont(&fonts::Font2);
     spr.setTextSize(1.0);
     spr.setTextDatum(textdatum_t::bottom_left);
     spr.drawString("Veille auto.", stepperX, stepperY - 4);
     // Bouton -
-    spr.fillRoundRect(stepperX, stepperY, btnW, btnH, 5, colMagenta);
-    spr.setTextColor(colYellow);
+    spr.fillRoundRect(stepperX, stepperY, btnW, btnH, 5, paletteColor(spr, palMagenta));
+    spr.setTextColor(paletteColor(spr, palYellow));
     spr.setTextSize(1.0);
     spr.setTextDatum(textdatum_t::middle_center);
     spr.drawString("-", stepperX + btnW / 2, stepperY + btnH / 2);
     // Valeur
-    spr.fillRoundRect(stepperX + btnW + 6, stepperY, valueW, valueH, 5, colBackground);
-    spr.setTextColor(colMagenta);
+    spr.fillRoundRect(stepperX + btnW + 6, stepperY, valueW, valueH, 5, paletteColor(spr, palBackground));
+    spr.setTextColor(paletteColor(spr, palMagenta));
     spr.setFont(&fonts::Font2);
     spr.setTextSize(1.0);
     char buf[16];
     snprintf(buf, sizeof(buf), "%d min", (int)Config::awakeTime);
     spr.drawString(buf, stepperX + btnW + 6 + valueW / 2, stepperY + valueH / 2);
     // Bouton +
-    spr.fillRoundRect(stepperX + btnW + 6 + valueW + 6, stepperY, btnW, btnH, 5, colMagenta);
-    spr.setTextColor(colYellow);
+    spr.fillRoundRect(stepperX + btnW + 6 + valueW + 6, stepperY, btnW, btnH, 5, paletteColor(spr, palMagenta));
+    spr.setTextColor(paletteColor(spr, palYellow));
     spr.setTextSize(1.0);
     spr.drawString("+", stepperX + btnW + 6 + valueW + 6 + btnW / 2, stepperY + btnH / 2);
 
@@ -117,14 +129,14 @@ void ViewSettings::render(LGFX &display, LGFX_Sprite &spr)
     int cbx = m_checkboxRotX;
     int cby = m_checkboxRotY;
     int cbsize = 20;
-    spr.drawRect(cbx, cby, cbsize, cbsize, colCyan);
+    spr.drawRect(cbx, cby, cbsize, cbsize, paletteColor(spr, palCyan));
     if (Config::display_rotated)
     {
         // Draw checkmark
-        spr.drawLine(cbx + 3, cby + cbsize / 2, cbx + cbsize / 2 - 1, cby + cbsize - 3, colCyan);
-        spr.drawLine(cbx + cbsize / 2 - 1, cby + cbsize - 3, cbx + cbsize - 3, cby + 3, colCyan);
+        spr.drawLine(cbx + 3, cby + cbsize / 2, cbx + cbsize / 2 - 1, cby + cbsize - 3, paletteColor(spr, palCyan));
+        spr.drawLine(cbx + cbsize / 2 - 1, cby + cbsize - 3, cbx + cbsize - 3, cby + 3, paletteColor(spr, palCyan));
     }
-    spr.setTextColor(colCyan);
+    spr.setTextColor(paletteColor(spr, palCyan));
     spr.setFont(&fonts::Font2);
     spr.setTextSize(1.0);
     spr.setTextDatum(textdatum_t::middle_left);
@@ -133,6 +145,36 @@ void ViewSettings::render(LGFX &display, LGFX_Sprite &spr)
     // Réinitialiser la police à la fin du rendu
     spr.setFont(nullptr);
     spr.setTextSize(1.0);
+
+    reportDamage();
+}
+
+void ViewSettings::reportDamage()
+{
+    // Largeur réservée à la valeur affichée à droite des sliders ("100%")
+    const int valueTextW = 48;
+
+    if ((int)Config::activeBrightness != m_lastBrightness)
+    {
+        addDamage(m_sliderX - 1, m_sliderY - 1, m_sliderW + 10 + valueTextW, m_sliderH + 2);
+        m_lastBrightness = Config::activeBrightness;
+    }
+    if ((int)Config::sleepBrightness != m_lastSleepBrightness)
+    {
+        addDamage(m_sliderSleepX - 1, m_sliderSleepY - 1, m_sliderSleepW + 10 + valueTextW, m_sliderSleepH + 2);
+        m_lastSleepBrightness = Config::sleepBrightness;
+    }
+    if ((int)Config::awakeTime != m_lastAwakeTime)
+    {
+        // Case de valeur du stepper, entre les boutons - et +
+        addDamage(m_stepperAwakeX + m_stepperBtnW + 6, m_stepperAwakeY + 20, 55, m_stepperBtnH);
+        m_lastAwakeTime = (int)Config::awakeTime;
+    }
+    if ((int)Config::display_rotated != m_lastRotated)
+    {
+        addDamage(m_checkboxRotX, m_checkboxRotY, 20, 20);
+        m_lastRotated = Config::display_rotated;
+    }
 }
 
 void ViewSettings::updateBrightnessFromTouch(int x)
@@ -193,18 +235,18 @@ void ViewSettings::updateAwakeTimeStepper(bool increment)
     this->m_displayManager.updateAwakeTime(value);
 }
 
-bool ViewSettings::handleTouch(int x, int y)
+// Le clic (Tap) arrive par handleTouch() depuis DisplayManager. Les échantillons du doigt
+// posé ne déclenchent rien (sinon la case et les boutons basculeraient à chaque échantillon),
+// seul un glissé déplace les curseurs.
+bool ViewSettings::handleTouchEvent(const TouchEvent &event)
 {
-    // Checkbox rotation
-    int cbx = m_checkboxRotX;
-    int cby = m_checkboxRotY + 20;
-    int cbsize = 20;
-    if (isRectanglePressed(cbx, cby, cbsize, cbsize, x, y))
-    {
-        toggleRotation();
-        return true;
-    }
+    if (event.type == TouchEvent::Drag)
+        return handleSliderTouch(event.x, event.y);
+    return false;
+}
 
+bool ViewSettings::handleSliderTouch(int x, int y)
+{
     // Slider luminosité active
     if (isRectanglePressed(m_sliderX, m_sliderY, m_sliderW, m_sliderH, x, y))
     {
@@ -217,6 +259,24 @@ bool ViewSettings::handleTouch(int x, int y)
         updateSleepBrightnessFromTouch(x);
         return true;
     }
+    return false;
+}
+
+bool ViewSettings::handleTouch(int x, int y)
+{
+    // Checkbox rotation
+    int cbx = m_checkboxRotX;
+    int cby = m_checkboxRotY + 20;
+    int cbsize = 20;
+    if (isRectanglePressed(cbx, cby, cbsize, cbsize, x, y))
+    {
+        toggleRotation();
+        return true;
+    }
+
+    if (handleSliderTouch(x, y))
+        return true;
+
     // Stepper veille auto
     int stepperX = this->m_stepperAwakeX;
     int stepperY = this->m_stepperAwakeY + 20;
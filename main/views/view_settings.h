@@ -15,13 +15,33 @@ class DisplayManager;
 class ViewSettings : public View
 {
 public:
+    // Index des couleurs rétro utilisées, dans la palette de la vue
+    enum Color
+    {
+        palBackground,
+        palCyan,
+        palYellow,
+        palPink,
+        palMagenta,
+        COLOR_COUNT
+    };
+
     ViewSettings(LGFX &lcd, DisplayManager &displayManager);
     void render(LGFX &display, LGFX_Sprite &spr) override;
     bool handleTouch(int x, int y) override;
+    bool handleTouchEvent(const TouchEvent &event) override;
+    const char *getName() const override { return "Settings"; }
+    // Statique : redessinée quand un touch modifie un réglage
+    int targetFps() const override { return 0; }
+    bool reportsDamage() const override { return true; }
+    // 5 couleurs : sprite à palette de 4 bits
+    int colorDepth() const override { return 4; }
+    const uint16_t *palette(int &count) const override;
 
 private:
     LGFX &m_lcd;
     DisplayManager &m_displayManager;
+    uint16_t m_palette[COLOR_COUNT];
     // Slider brightness
     int m_sliderX, m_sliderY, m_sliderW, m_sliderH;
     // Slider sleep brightness
@@ -31,7 +51,14 @@ private:
     int m_stepperBtnW, m_stepperBtnH;
     // Checkbox rotation
     int m_checkboxRotX = 20, m_checkboxRotY = 210, m_checkboxRotSize = 24;
+    // Dernières valeurs affichées (pour ne signaler que les widgets modifiés)
+    int m_lastBrightness = -1;
+    int m_lastSleepBrightness = -1;
+    int m_lastAwakeTime = -1;
+    int m_lastRotated = -1;
+    void reportDamage();
     void drawSlider(LGFX_Sprite &spr, int x, int y, int w, int h, int colorFill, int colorGlow, int colorLabel, int colorValue, float value, float min, float max, const char *valueFormat, const char *label, int valueInt = -1);
+    bool handleSliderTouch(int x, int y);
     void updateBrightnessFromTouch(int x);
     void updateSleepBrightnessFromTouch(int x);
     void updateAwakeTimeStepper(bool increment);